@@ -0,0 +1,38 @@
+#version 300 es
+
+precision highp float;
+
+uniform sampler2D uSampler;
+uniform sampler2D uNoise;
+
+in vec2 vLocal;
+flat in vec4 vWave;
+flat in vec4 vUv;
+flat in float vStart;
+flat in float vLength;
+in vec4 vCol;
+
+out vec4 fColor;
+
+// noise texture covers this many units of noise space, and repeats after that
+const vec2 period = vec2(64.0, 8.0);
+
+void main() {
+    float column = floor(vLocal.x);
+
+    // we don't want much movement near the ends, this has maximal value at the center
+    float strength = vWave.x * min(column, vLength - column);
+    float sigmoidal = 10.0 / (1.0 + exp(-0.5 * strength)) - 5.0;
+
+    // texel i holds the noise at i / 8, so shift by half a texel to hit the centers
+    vec2 size = vec2(textureSize(uNoise, 0));
+    vec2 point = vec2((vStart + column) * vWave.z + vWave.w, vWave.y) / period;
+    float noise = texture(uNoise, point + 0.5 / size).r;
+
+    // every column is a single tile, placed at the displaced row
+    if (floor(vLocal.y) != floor(sigmoidal * noise)) {
+        discard;
+    }
+
+    fColor = vCol * texture(uSampler, mix(vUv.xy, vUv.zw, fract(vLocal)));
+}
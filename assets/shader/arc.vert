@@ -0,0 +1,39 @@
+#version 300 es
+uniform mat4 uMatrix;
+uniform highp sampler2D uSprites;
+
+in vec4 iSpan;
+in vec4 iWave;
+in float iSprite;
+in vec4 iCol;
+
+out vec2 vLocal;
+flat out vec4 vWave;
+flat out vec4 vUv;
+flat out float vStart;
+flat out float vLength;
+out vec4 vCol;
+
+// same vertex order as the quad index pattern
+const int corners[6] = int[6](0, 1, 2, 2, 3, 0);
+const vec2 uvs[4] = vec2[4](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0));
+
+// the sigmoid in arc.frag never displaces a column by more than this many tiles
+const float reach = 5.0;
+
+void main() {
+    vec2 corner = uvs[corners[gl_VertexID]];
+
+    // local position in tiles, x from the first column and y from the baseline
+    vLocal = vec2(corner.x * iSpan.z, mix(-reach, reach + 1.0, corner.y));
+
+    // sprite table is 256 sprites wide, see Atlas::table_width
+    int sprite = int(iSprite + 0.5);
+    vUv = texelFetch(uSprites, ivec2(sprite % 256, sprite / 256), 0);
+
+    gl_Position = uMatrix * vec4(iSpan.xy + vLocal * iSpan.w, 1.0, 1.0);
+    vWave = iWave;
+    vStart = floor(iSpan.x / iSpan.w + 0.5);
+    vLength = iSpan.z;
+    vCol = iCol;
+}
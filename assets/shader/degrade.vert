@@ -2,7 +2,8 @@
 
 uniform mat4 uMatrix;
 
-in vec2 iPos;
+// shared by all CRT variants, which all use the same screen layout
+layout(location = 0) in vec2 iPos;
 
 out vec2 vTex;
 
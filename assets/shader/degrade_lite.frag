@@ -0,0 +1,55 @@
+#version 300 es
+
+#ifdef GL_FRAGMENT_PRECISION_HIGH
+    precision highp float;
+#else
+    precision mediump float;
+#endif
+
+uniform sampler2D uSampler;
+uniform sampler2D uCurve;
+uniform float uTime;
+uniform float uAliveness;
+uniform vec2 uResolution;
+
+vec2 getResolution() {
+#ifdef GL_FRAGMENT_PRECISION_HIGH
+    return uResolution;
+#else
+    return uResolution * 0.5f;
+#endif
+}
+
+in vec2 vTex;
+
+out vec4 fColor;
+
+// cheaper variant of degrade.frag, the curvature and vignette
+// are precomputed into uCurve and the chroma is sampled only once
+void main() {
+    const float pixelation = 2.0f;
+
+    vec2 res = getResolution();
+    vec3 curve = texture(uCurve, vTex.xy).xyz;
+    vec2 uv = curve.xy;
+
+    float x = sin(0.3*uTime+uv.y*21.0)*0.0017;
+    vec2 sourcePixel = round(vec2(x+uv.x, uv.y) * res / pixelation) * pixelation;
+
+    vec3 col = texture(uSampler, sourcePixel / res).rgb+0.05;
+
+    col = clamp(col*0.6+0.4*col*col*1.0,0.0,1.0);
+    col = mix(col, vec3(0.3, 1.0, 0.5), 0.20);
+
+    // vignette, zero outside of the curved screen
+    col *= curve.z;
+
+    col *= vec3(0.95,1.05,0.95);
+    col *= 2.8;
+
+    float scans = clamp( 0.35+0.35*sin(3.5*uTime+vTex.y * res.y *1.5), 0.0, 1.0);
+    col = col*vec3( 0.4+0.7*scans*scans) ;
+
+    col *= 1.0 - 0.65 * vec3(clamp((mod(vTex.x * res.x, 2.0) - 1.0) * 2.0, 0.0, 1.0));
+    fColor = vec4(col, 1.0) * (0.8f + uAliveness * 0.2f);
+}
@@ -1,5 +1,6 @@
 #version 300 es
 uniform mat4 uMatrix;
+uniform float uUnit;
 
 in vec2 iPos;
 in vec2 iTex;
@@ -9,7 +10,7 @@ out vec2 vTex;
 out vec4 vCol;
 
 void main() {
-    gl_Position = uMatrix * vec4(iPos.xy, 1.0, 1.0);
+    gl_Position = uMatrix * vec4(iPos.xy * uUnit, 1.0, 1.0);
     vTex = iTex;
     vCol = iCol;
 }
\ No newline at end of file
@@ -0,0 +1,29 @@
+#version 300 es
+uniform mat4 uMatrix;
+uniform highp sampler2D uSprites;
+
+in vec2 iPos;
+in vec2 iSize;
+in float iAngle;
+in float iSprite;
+in vec4 iCol;
+
+out vec2 vTex;
+out vec4 vCol;
+
+// same vertex order as the quad index pattern
+const int corners[6] = int[6](0, 1, 2, 2, 3, 0);
+const vec2 uvs[4] = vec2[4](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0));
+
+void main() {
+    int corner = corners[gl_VertexID];
+    float angle = 2.35619449 + iAngle + float(corner) * 1.57079633;
+
+    // sprite table is 256 sprites wide, see Atlas::table_width
+    int sprite = int(iSprite + 0.5);
+    vec4 uv = texelFetch(uSprites, ivec2(sprite % 256, sprite / 256), 0);
+
+    gl_Position = uMatrix * vec4(iPos + vec2(sin(angle), cos(angle)) * iSize, 1.0, 1.0);
+    vTex = mix(uv.xy, uv.zw, uvs[corner]);
+    vCol = iCol;
+}
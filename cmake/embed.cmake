@@ -0,0 +1,39 @@
+# Turns files into a C++ source with their contents, keyed by path relative to ROOT
+# usage: cmake -DROOT=<dir> -DOUTPUT=<file.cpp> -DFILES="<a>;<b>" -P embed.cmake
+
+set(entries "")
+set(arrays "")
+set(index 0)
+
+foreach(path IN LISTS FILES)
+	file(READ "${ROOT}/${path}" content HEX)
+	string(LENGTH "${content}" length)
+	math(EXPR size "${length} / 2")
+
+	string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${content}")
+	string(APPEND arrays "static const unsigned char file_${index}[] = {${bytes}0};\n")
+	string(APPEND entries "\t{\"${path}\", {reinterpret_cast<const char*>(file_${index}), ${size}}},\n")
+
+	math(EXPR index "${index} + 1")
+endforeach()
+
+file(WRITE "${OUTPUT}.tmp"
+	"// generated by cmake/embed.cmake, do not edit\n"
+	"#include <render/embedded.hpp>\n\n"
+	"${arrays}\n"
+	"static const std::pair<std::string_view, std::string_view> files[] = {\n"
+	"${entries}"
+	"};\n\n"
+	"std::string_view getEmbeddedFile(std::string_view path) {\n"
+	"\tfor (const auto& [name, content] : files) {\n"
+	"\t\tif (name == path) {\n"
+	"\t\t\treturn content;\n"
+	"\t\t}\n"
+	"\t}\n\n"
+	"\treturn {};\n"
+	"}\n"
+)
+
+# only touch the output if something changed, so that it doesn't trigger a rebuild
+configure_file("${OUTPUT}.tmp" "${OUTPUT}" COPYONLY)
+file(REMOVE "${OUTPUT}.tmp")
@@ -2,3 +2,8 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #include <stb_vorbis.c>
+
+#if defined(GAME_HEADLESS)
+	#define STB_IMAGE_WRITE_IMPLEMENTATION
+	#include <stb_image_write.h>
+#endif
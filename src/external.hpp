@@ -4,6 +4,7 @@
 
 // C
 #include <cinttypes>
+#include <cstdarg>
 
 // GLM extensions
 #define GLM_ENABLE_EXPERIMENTAL
@@ -14,6 +15,7 @@
 #include <memory>
 #include <stdexcept>
 #include <list>
+#include <map>
 #include <algorithm>
 #include <array>
 #include <random>
@@ -22,6 +24,12 @@
 #include <filesystem>
 #include <regex>
 #include <ranges>
+#include <bit>
+#include <limits>
+#include <numeric>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 
 // emscripten
 #include <platform.hpp>
@@ -42,4 +50,7 @@
 /// Can be used to mark pointers that can be null
 #define NULLABLE
 
+/// Lets the compiler check the arguments of printf-like functions, indices start at 1 and count the implicit this
+#define PRINTF_FORMAT(string, first) __attribute__((format(printf, string, first)))
+
 using Runnable = std::function<void()>;
@@ -3,63 +3,100 @@
 
 #include "level/level.hpp"
 
-void emitSpriteQuad(BufferWriter<Vert4f4b>& writer, float tx, float ty, float sx, float sy, float angle, const Sprite& s, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
-	double quarter = M_PI / 2;
-	double start = M_PI / 4 + M_PI / 2 + angle;
-
-	auto getUnitPoint = [=] (int index) {
-		return glm::vec2 {sin(start + quarter * index) * sx, cos(start + quarter * index) * sy};
-	};
-
-	glm::vec2 v0 = getUnitPoint(0);
-	glm::vec2 v1 = getUnitPoint(1);
-	glm::vec2 v2 = getUnitPoint(2);
-	glm::vec2 v3 = getUnitPoint(3);
-
-	writer.push({tx + v0.x, v0.y + ty, s.min_u, s.min_v, r, g, b, a});
-	writer.push({tx + v1.x, v1.y + ty, s.max_u, s.min_v, r, g, b, a});
-	writer.push({tx + v2.x, v2.y + ty, s.max_u, s.max_v, r, g, b, a});
-
-	writer.push({tx + v2.x, v2.y + ty, s.max_u, s.max_v, r, g, b, a});
-	writer.push({tx + v3.x, v3.y + ty, s.min_u, s.max_v, r, g, b, a});
-	writer.push({tx + v0.x, v0.y + ty, s.min_u, s.min_v, r, g, b, a});
+void emitSprite(RenderLayer& layer, float tx, float ty, float sx, float sy, float angle, uint32_t sprite, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+	layer.sprite({tx, ty, sx, sy, angle, sprite, r, g, b, a});
 }
 
-void emitLineQuad(BufferWriter<Vert4f4b>& writer, float x1, float y1, float x2, float y2, float width, const Sprite& s, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+void emitLineQuad(RenderLayer& layer, float x1, float y1, float x2, float y2, float width, const Sprite& s, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+	const float ox = y1 - y2;
+	const float oy = x2 - x1;
+	const float scale = width / std::sqrt(ox * ox + oy * oy);
 
-	float dx = y1 - y2;
-	float dy = x2 - x1;
-	float dl = sqrt(dx * dx + dy * dy);
+	const float dx = ox * scale;
+	const float dy = oy * scale;
 
-	dx /= dl;
-	dy /= dl;
+	layer.quad(
+		{x1 + dx, y1 + dy, s.min_u, s.min_v, r, g, b, a},
+		{x1 - dx, y1 - dy, s.max_u, s.min_v, r, g, b, a},
+		{x2 - dx, y2 - dy, s.max_u, s.max_v, r, g, b, a},
+		{x2 + dx, y2 + dy, s.min_u, s.max_v, r, g, b, a}
+	);
+}
 
-	dx *= width;
-	dy *= width;
+void emitTextQuads(RenderLayer& layer, float x, float y, float spacing, float size, uint8_t r, uint8_t g, uint8_t b, uint8_t a, const std::string& str, TextMode mode) {
 
-	writer.push({x1 + dx, y1 + dy, s.min_u, s.min_v, r, g, b, a});
-	writer.push({x2 - dx, y2 - dy, s.max_u, s.max_v, r, g, b, a});
-	writer.push({x2 + dx, y2 + dy, s.min_u, s.max_v, r, g, b, a});
+	int length = str.length() * spacing;
+	float offset = - length * ((int) mode) / 2.0f;
 
-	writer.push({x1 + dx, y1 + dy, s.min_u, s.min_v, r, g, b, a});
-	writer.push({x1 - dx, y1 - dy, s.max_u, s.min_v, r, g, b, a});
-	writer.push({x2 - dx, y2 - dy, s.max_u, s.max_v, r, g, b, a});
+	for (size_t i = 0; i < str.length(); i ++) {
+		uint32_t glyph = layer.tileset->cell((uint8_t) str[i]);
+		emitSprite(layer, x + offset, y, -size, size, 0, glyph, r, g, b, a);
+
+		offset += spacing;
+	}
 }
 
-void emitTextQuads(RenderLayer& layer, float x, float y, float spacing, float size, uint8_t r, uint8_t g, uint8_t b, uint8_t a, const std::string& str, TextMode mode) {
+/*
+ * TextMesh
+ */
 
-	int length = str.length() * spacing;
+TextMesh::TextMesh(float x, float y, float spacing, float size, Color color, TextMode mode)
+: x(x), y(y), spacing(spacing), size(size), color(color), mode(mode) {}
+
+void TextMesh::build(const TileSet& tileset) {
+	int length = text.length() * spacing;
 	float offset = - length * ((int) mode) / 2.0f;
 
-	for (int i = 0; i < str.length(); i ++) {
-		Sprite glyph = layer.tileset->sprite(str[i]);
-		emitSpriteQuad(*layer.writer, x + offset, y, -size, size, 0, glyph, r, g, b, a);
+	glyphs.clear();
 
+	for (char glyph : text) {
+		glyphs.emplace_back(x + offset, y, -size, size, 0, tileset.cell((uint8_t) glyph), color.r, color.g, color.b, color.a);
 		offset += spacing;
 	}
+
+	this->tileset = &tileset;
+	this->dirty = false;
+}
+
+void TextMesh::set(std::string_view text) {
+	if (text == this->text) {
+		return;
+	}
+
+	// the layout only depends on the length, so just swap the changed glyphs
+	if (!dirty && text.length() == this->text.length()) {
+		for (size_t i = 0; i < text.length(); i ++) {
+			if (text[i] != this->text[i]) {
+				glyphs[i].sprite = tileset->cell((uint8_t) text[i]);
+			}
+		}
+	} else {
+		dirty = true;
+	}
+
+	this->text.assign(text);
+}
+
+void TextMesh::print(const char* format, ...) {
+	char buffer[64];
+
+	va_list args;
+	va_start(args, format);
+	int length = vsnprintf(buffer, sizeof(buffer), format, args);
+	va_end(args);
+
+	set(std::string_view {buffer, (size_t) std::clamp(length, 0, (int) sizeof(buffer) - 1)});
+}
+
+void TextMesh::emit(RenderLayer& layer) {
+	if (dirty || tileset != layer.tileset) {
+		build(*layer.tileset);
+	}
+
+	layer.sprites(glyphs);
 }
 
-void emitTileQuad(BufferWriter<Vert4f4b>& writer, Sprite s, int x, int y, float ox, float oy, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+void emitTileQuad(RenderLayer& layer, const Sprite& s, int x, int y, float ox, float oy, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
 	const float unit = SW / Segment::width;
 
 	const float tx = x * unit + ox;
@@ -68,10 +105,10 @@ void emitTileQuad(BufferWriter<Vert4f4b>& writer, Sprite s, int x, int y, float
 	const float ex = tx + unit;
 	const float ey = ty + unit;
 
-	writer.push({tx, ty, s.min_u, s.min_v, r, g, b, a});
-	writer.push({ex, ty, s.max_u, s.min_v, r, g, b, a});
-	writer.push({ex, ey, s.max_u, s.max_v, r, g, b, a});
-	writer.push({ex, ey, s.max_u, s.max_v, r, g, b, a});
-	writer.push({tx, ey, s.min_u, s.max_v, r, g, b, a});
-	writer.push({tx, ty, s.min_u, s.min_v, r, g, b, a});
+	layer.quad(
+		{tx, ty, s.min_u, s.min_v, r, g, b, a},
+		{ex, ty, s.max_u, s.min_v, r, g, b, a},
+		{ex, ey, s.max_u, s.max_v, r, g, b, a},
+		{tx, ey, s.min_u, s.max_v, r, g, b, a}
+	);
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "external.hpp"
 #include "rendering.hpp"
+#include "color.hpp"
 
 struct RenderLayer;
 
@@ -11,7 +12,38 @@ enum struct TextMode {
 	RIGHT  = 2,
 };
 
-void emitSpriteQuad(BufferWriter<Vert4f4b>& writer, float tx, float ty, float sx, float sy, float angle, const Sprite& s, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
-void emitLineQuad(BufferWriter<Vert4f4b>& writer, float x1, float y1, float x2, float y2, float width, const Sprite& s, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+/// Retained glyphs of a single line of text, regenerated only when the text changes
+class TextMesh {
+
+	private:
+
+		float x, y, spacing, size;
+		Color color;
+		TextMode mode;
+
+		std::string text;
+		std::vector<SpriteInstance> glyphs;
+		NULLABLE const TileSet* tileset = nullptr;
+		bool dirty = true;
+
+		void build(const TileSet& tileset);
+
+	public:
+
+		TextMesh(float x, float y, float spacing, float size, Color color, TextMode mode);
+
+		/// Change the text, glyphs of an equally long text are updated in place
+		void set(std::string_view text);
+
+		/// Change the text using a printf-like format, without allocating
+		void print(const char* format, ...) PRINTF_FORMAT(2, 3);
+
+		/// Write the glyphs into the given layer
+		void emit(RenderLayer& layer);
+
+};
+
+void emitSprite(RenderLayer& layer, float tx, float ty, float sx, float sy, float angle, uint32_t sprite, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+void emitLineQuad(RenderLayer& layer, float x1, float y1, float x2, float y2, float width, const Sprite& s, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
 void emitTextQuads(RenderLayer& layer, float x, float y, float spacing, float size, uint8_t r, uint8_t g, uint8_t b, uint8_t a, const std::string& str, TextMode mode);
-void emitTileQuad(BufferWriter<Vert4f4b>& writer, Sprite s, int x, int y, float ox, float oy, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
\ No newline at end of file
+void emitTileQuad(RenderLayer& layer, const Sprite& s, int x, int y, float ox, float oy, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
\ No newline at end of file
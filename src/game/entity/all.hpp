@@ -1,15 +1,9 @@
 #pragma once
 
-#include "bullet.hpp"
 #include "player.hpp"
 #include "powerup.hpp"
 #include "shield.hpp"
 
-// particles
-#include "particle/blow.hpp"
-#include "particle/tile.hpp"
-#include "particle/dust.hpp"
-
 // aliens
 #include "enemy/alien.hpp"
 #include "enemy/sweeper.hpp"
@@ -1,9 +1,7 @@
 
 #include "alien.hpp"
 
-#include "game/entity/bullet.hpp"
 #include "game/level/level.hpp"
-#include "game/entity/particle/dust.hpp"
 
 /*
  * AlienEntity
@@ -12,6 +10,10 @@
 AlienEntity::AlienEntity(float x, float y, int evolution)
 : Entity(32, x, y) {
 	this->evolution = evolution;
+	this->layer = CollisionLayer::ENEMY;
+
+	// aliens also collide with each other, that's how their placement gets checked
+	this->mask = maskOf(CollisionLayer::PLAYER, CollisionLayer::PLAYER_BULLET, CollisionLayer::ENEMY, CollisionLayer::ENEMY_BULLET);
 }
 
 void AlienEntity::spawnParticles(Level& level, int min, int max, float ovx, float ovy) {
@@ -19,7 +21,7 @@ void AlienEntity::spawnParticles(Level& level, int min, int max, float ovx, floa
 		float vx = randomFloat(-1, 1) + ovx;
 		float vy = randomFloat(-1, 1) + ovy;
 
-		level.addEntity(new DustEntity {x, y, vx, vy, 1, 1, 1, 30, Color::red()});
+		level.getParticles().dust(x, y, vx, vy, 1, 1, 1, 30, Color::red());
 	}
 }
 
@@ -38,22 +40,35 @@ void AlienEntity::onDamage(Level& level, int damage, NULLABLE Entity* damager) {
 	}
 
 	if (damager && damager->isCausedByPlayer()) {
+		hurt(level);
+	}
+}
 
-		this->attacked = true;
-		this->health --;
-		this->damage_ticks = 4;
+void AlienEntity::hurt(Level& level) {
+	this->attacked = true;
+	this->health --;
+	this->damage_ticks = 4;
 
-		if (BulletEntity* bullet = dynamic_cast<BulletEntity*>(damager)) {
-			if (bullet->isCharged()) stan_ticks = 90 + randomInt(0, 60);
-		}
+	onDamaged(level);
+
+	if (health <= 0) {
+		this->dead = true;
+		onKilled(level);
+	}
+}
 
-		onDamaged(level);
+void AlienEntity::onHit(Level& level, const BulletHit& hit) {
 
-		if (health <= 0) {
-			this->dead = true;
-			onKilled(level);
-		}
+	// only the player can hurt aliens, the side comes from the bullet as the shooter may already be gone
+	if (!hit.player) {
+		return;
+	}
+
+	hurt(level);
 
+	// charged bullets also stun the alien
+	if (hit.config.charged) {
+		stan_ticks = 90 + randomInt(0, 60);
 	}
 }
 
@@ -75,7 +90,7 @@ void AlienEntity::tick(Level& level) {
 			float vx = 0.2f * randomFloat(-1, 1);
 			float vy = 0.2f * randomFloat(-1, 1);
 
-			level.addEntity(new DustEntity {ox, oy, vx, vy, 1, 1, 1, 30, Color::red(true)});
+			level.getParticles().dust(ox, oy, vx, vy, 1, 1, 1, 30, Color::red(true));
 		}
 	}
 }
@@ -24,9 +24,13 @@ class AlienEntity : public Entity {
 		/// Check if this entity was hit by the player before
 		bool wasAttacked() const;
 
+		/// Take a single point of damage dealt by the player
+		void hurt(Level& level);
+
 	public:
 
 		void onDamage(Level& level, int damage, Entity* damager) override;
+		void onHit(Level& level, const BulletHit& hit) override;
 		void tick(Level& level) override;
 		void onDespawn(Level& level) override;
 
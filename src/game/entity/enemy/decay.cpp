@@ -1,7 +1,6 @@
 #include "decay.hpp"
 
 #include "game/sounds.hpp"
-#include "game/entity/bullet.hpp"
 #include "game/level/level.hpp"
 #include "sound/system.hpp"
 
@@ -9,19 +8,15 @@ DecaySharedState::~DecaySharedState() {
 	printf("Unloaded shared decay state\n");
 }
 
-std::shared_ptr<DecayEntity> DecaySharedState::createPart(float x, float y) {
-	auto self = shared_from_this();
-	auto part = std::make_shared<DecayEntity>(x, y, self);
-
-	glm::ivec2 vec {x/32, y/32};
-	parts[vec] = part;
-
-	return part;
+DecayEntity* DecaySharedState::createPart(float x, float y) {
+	return new DecayEntity {x, y, shared_from_this()};
 }
 
-std::shared_ptr<DecayEntity> DecaySharedState::getPart(float x, float y) {
+DecayEntity* DecaySharedState::getPart(const Level& level, float x, float y) {
 	glm::ivec2 vec {x/32, y/32};
-	return parts[vec].lock();
+	auto it = parts.find(vec);
+
+	return it == parts.end() ? nullptr : level.getEntity<DecayEntity>(it->second);
 }
 
 DecayEntity::DecayEntity(float x, float y, const std::shared_ptr<DecaySharedState>& shared)
@@ -32,10 +27,23 @@ DecayEntity::DecayEntity(float x, float y, const std::shared_ptr<DecaySharedStat
 	row_2 = randomInt(0, 7);
 }
 
+void* DecayEntity::operator new(size_t size) {
+	return SlabPool<DecayEntity>::allocate(size);
+}
+
+void DecayEntity::operator delete(void* pointer, size_t size) {
+	SlabPool<DecayEntity>::deallocate(pointer, size);
+}
+
 bool DecayEntity::checkPlacement(Level& level) {
 	return true;
 }
 
+void DecayEntity::onSpawned(const Level& level, Segment* segment) {
+	glm::ivec2 vec {x/32, y/32};
+	shared->parts[vec] = self();
+}
+
 // void DecayEntity::onDamage(Level& level, int damage, Entity* damager) {
 // 	Entity::onDamage(level, damage, damager);
 // }
@@ -50,8 +58,8 @@ void DecayEntity::tick(Level& level) {
 		row_1 = randomInt(0, 7);
 		row_2 = randomInt(0, 7);
 
-		if (shared->getPart(x, y - 32) == nullptr) {
-			level.addEntity(new BulletEntity{-3, x, y - 24, self(), false});
+		if (shared->getPart(level, x, y - 32) == nullptr) {
+			level.getBullets().spawn(this, -3, x, y - 24, 0);
 		}
 
 		cb = Color::of(200, randomInt(50, 100), randomInt(50, 100));
@@ -73,10 +81,10 @@ void DecayEntity::tick(Level& level) {
 }
 
 void DecayEntity::draw(Level& level, Renderer& renderer) {
-	auto& writer = *renderer.terrain.writer;
-	auto& tileset = *renderer.terrain.tileset;
+	auto& layer = renderer.terrain;
+	auto& tileset = *layer.tileset;
 
-	emitEntityQuad(level, writer, tileset.sprite(base, 10), size, angle, cb);
-	emitEntityQuad(level, writer, tileset.sprite(row_1, 12), size, angle, Color::red(true));
-	emitEntityQuad(level, writer, tileset.sprite(row_2, 11), size, angle, Color::red(true));
+	emitEntityQuad(level, layer, tileset.cell(base, 10), size, angle, cb);
+	emitEntityQuad(level, layer, tileset.cell(row_1, 12), size, angle, Color::red(true));
+	emitEntityQuad(level, layer, tileset.cell(row_2, 11), size, angle, Color::red(true));
 }
@@ -5,14 +5,16 @@ class DecayEntity;
 
 class DecaySharedState : public std::enable_shared_from_this<DecaySharedState> {
 
-		std::unordered_map<glm::ivec2, std::weak_ptr<DecayEntity>> parts;
+		friend class DecayEntity;
+		std::unordered_map<glm::ivec2, EntityHandle> parts;
 
 	public:
 
 		~DecaySharedState();
 
-		std::shared_ptr<DecayEntity> createPart(float x, float y);
-		std::shared_ptr<DecayEntity> getPart(float x, float y);
+		/// Create a part, it's registered in the shared state once it is spawned
+		DecayEntity* createPart(float x, float y);
+		DecayEntity* getPart(const Level& level, float x, float y);
 
 };
 
@@ -29,7 +31,11 @@ class DecayEntity : public AlienEntity {
 
 		DecayEntity(float x, float y, const std::shared_ptr<DecaySharedState>& shared);
 
+		static void* operator new(size_t size);
+		static void operator delete(void* pointer, size_t size);
+
 		bool checkPlacement(Level& level) override;
+		void onSpawned(const Level& level, Segment* segment) override;
 		// void onDamage(Level& level, int damage, Entity* damager) override;
 
 		void tick(Level& level) override;
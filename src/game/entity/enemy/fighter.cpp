@@ -1,7 +1,6 @@
 
 #include "fighter.hpp"
 
-#include "game/entity/bullet.hpp"
 #include "game/level/level.hpp"
 #include "game/emitter.hpp"
 
@@ -15,29 +14,35 @@ FighterAlienEntity::FighterAlienEntity(double x, double y, int evolution)
 	// player offset targets
 	this->px = -80;
 	this->py = 220;
+	this->kind = EntityKind::FIGHTER;
 }
 
-void FighterAlienEntity::forEachDanger(Level& level, const std::function<void(BulletEntity*, float, float)>& callback) {
+void* FighterAlienEntity::operator new(size_t size) {
+	return SlabPool<FighterAlienEntity>::allocate(size);
+}
 
-	for (auto& entity : level.getEntities()) {
-		if (BulletEntity* bullet = dynamic_cast<BulletEntity*>(entity.get())) {
-			if (bullet->isCausedByPlayer()) {
+void FighterAlienEntity::operator delete(void* pointer, size_t size) {
+	SlabPool<FighterAlienEntity>::deallocate(pointer, size);
+}
 
-				// from this to bullet
-				float dx = bullet->x - this->x;
-				float dy = bullet->y - this->y;
+template <typename F>
+void FighterAlienEntity::forEachDanger(Level& level, F callback) {
 
-				// ignore bullets above us
-				if (dy > 0) continue;
+	level.getBullets().forEach(true, [&] (glm::vec2 bullet) {
 
-				// ignore bullets that are too far away
-				if (dy < -200) continue;
-				if (std::abs(dx) > 100) continue;
+		// from this to bullet
+		float dx = bullet.x - this->x;
+		float dy = bullet.y - this->y;
 
-				callback(bullet, dx, dy);
-			}
-		}
-	}
+		// ignore bullets above us
+		if (dy > 0) return;
+
+		// ignore bullets that are too far away
+		if (dy < -200) return;
+		if (std::abs(dx) > 100) return;
+
+		callback(bullet, dx, dy);
+	});
 
 }
 
@@ -127,7 +132,7 @@ void FighterAlienEntity::onKilled(Level& level) {
 void FighterAlienEntity::tick(Level& level) {
 
 	this->cooldown -= 0.05f;
-	auto player = level.getPlayer();
+	PlayerEntity* player = level.getPlayer();
 
 	if (avoiding > 0) {
 		avoiding --;
@@ -137,23 +142,23 @@ void FighterAlienEntity::tick(Level& level) {
 	float ay = 0;
 
 	// make sure we only have one fighter at once
-	for (auto& entity : level.getEntities()) {
-		if (FighterAlienEntity* fighter = dynamic_cast<FighterAlienEntity*>(entity.get())) {
-			if (!fighter->escape && (fighter != this)) {
-				float dx = fighter->x - this->x;
-				float dy = fighter->y - this->y;
-
-				float len = sqrt(dx * dx + dy * dy);
-
-				if (len < 100) {
-					this->escape = true;
-					break;
-				}
+	for (Entity* entity : level.getEntities(EntityKind::FIGHTER)) {
+		FighterAlienEntity* fighter = static_cast<FighterAlienEntity*>(entity);
+
+		if (!fighter->escape && (fighter != this)) {
+			float dx = fighter->x - this->x;
+			float dy = fighter->y - this->y;
+
+			float len = sqrt(dx * dx + dy * dy);
+
+			if (len < 100) {
+				this->escape = true;
+				break;
 			}
 		}
 	}
 
-	forEachDanger(level, [&] (BulletEntity* bullet, float dx, float dy) {
+	forEachDanger(level, [&] (glm::vec2 bullet, float dx, float dy) {
 		// otherwise try to avoid
 		ax -= signum(dx) * 2;
 
@@ -214,7 +219,7 @@ void FighterAlienEntity::tick(Level& level) {
 		cooldown = 1;
 
 		if (visible) {
-			level.addEntity(new BulletEntity{-3, x, y - 24, self(), M_PI});
+			level.getBullets().spawn(this, -3, x, y - 24, M_PI);
 		}
 	}
 
@@ -223,14 +228,14 @@ void FighterAlienEntity::tick(Level& level) {
 }
 
 void FighterAlienEntity::draw(Level& level, Renderer& renderer) {
-	emitEntityQuad(level, *renderer.terrain.writer, renderer.terrain.tileset->sprite(evolution, 7), size, angle, Color::red(damage_ticks));
+	emitEntityQuad(level, renderer.terrain, renderer.terrain.tileset->cell(evolution, 7), size, angle, Color::red(damage_ticks));
 }
 
 void FighterAlienEntity::debugDraw(Level& level, Renderer& renderer) {
-	auto player = level.getPlayer();
+	PlayerEntity* player = level.getPlayer();
 
-	auto& writer = *renderer.terrain.writer;
-	auto& tileset = *renderer.terrain.tileset;
+	auto& layer = renderer.debug;
+	auto& tileset = *layer.tileset;
 
 	if (player) {
 		float tx = px + player->x;
@@ -238,27 +243,27 @@ void FighterAlienEntity::debugDraw(Level& level, Renderer& renderer) {
 
 		int ox = 0;
 
-		emitSpriteQuad(writer, tx, ty - 16, 16, 16, angle, tileset.sprite(6, 1), 0, 255, 0, 255);
-		emitLineQuad(writer, x, y + level.getScroll(), tx, ty - 16, 2, tileset.sprite(0, 0), 0, 255, 0, 100);
+		emitSprite(layer, tx, ty - 16, 16, 16, angle, tileset.cell(6, 1), 0, 255, 0, 255);
+		emitLineQuad(layer, x, y + level.getScroll(), tx, ty - 16, 2, tileset.sprite(0, 0), 0, 255, 0, 100);
 
 		if (down) {
 			ox += 24;
-			emitSpriteQuad(writer, tx + ox, ty - 16, 16, 16, angle, tileset.sprite(0, 0), 155, 155, 0, 255);
+			emitSprite(layer, tx + ox, ty - 16, 16, 16, angle, tileset.cell(0, 0), 155, 155, 0, 255);
 		}
 
 		if (underhung) {
 			ox += 24;
-			emitSpriteQuad(writer, tx + ox, ty - 16, 16, 16, angle, tileset.sprite(0, 0), 255, 0, 0, 255);
+			emitSprite(layer, tx + ox, ty - 16, 16, 16, angle, tileset.cell(0, 0), 255, 0, 0, 255);
 		}
 
 		if (escape) {
 			ox += 24;
-			emitSpriteQuad(writer, tx + ox, ty - 16, 16, 16, angle, tileset.sprite(0, 0), 0, 0, 255, 255);
+			emitSprite(layer, tx + ox, ty - 16, 16, 16, angle, tileset.cell(0, 0), 0, 0, 255, 255);
 		}
 	}
 
-	forEachDanger(level, [&] (BulletEntity* bullet, float dx, float dy) {
-		emitLineQuad(writer, x, y + level.getScroll(), bullet->x, bullet->y + level.getScroll() - 16, 2, tileset.sprite(0, 0), 255, 0, 0, 100);
+	forEachDanger(level, [&] (glm::vec2 bullet, float dx, float dy) {
+		emitLineQuad(layer, x, y + level.getScroll(), bullet.x, bullet.y + level.getScroll() - 16, 2, tileset.sprite(0, 0), 255, 0, 0, 100);
 	});
 
 	Entity::debugDraw(level, renderer);
@@ -2,8 +2,6 @@
 
 #include "alien.hpp"
 
-class BulletEntity;
-
 class FighterAlienEntity : public AlienEntity {
 
 	private:
@@ -20,13 +18,18 @@ class FighterAlienEntity : public AlienEntity {
 		bool underhung = false;
 		bool down = false;
 
-		void forEachDanger(Level& level, const std::function<void(BulletEntity*, float, float)>& callback);
+		/// Invoke the callback with each player bullet heading towards us, and its offset from us
+		template <typename F>
+		void forEachDanger(Level& level, F callback);
 		bool tickMovement(Level& level);
 
 	public:
 
 		FighterAlienEntity(double x, double y, int evolution);
 
+		static void* operator new(size_t size);
+		static void operator delete(void* pointer, size_t size);
+
 		bool checkPlacement(Level& level) override;
 
 		void onKilled(Level& level) override;
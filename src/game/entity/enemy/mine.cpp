@@ -4,8 +4,6 @@
 #include <game/level/level.hpp>
 #include <game/sounds.hpp>
 #include <sound/system.hpp>
-#include "game/entity/particle/blow.hpp"
-#include "game/entity/bullet.hpp"
 #include "game/entity/player.hpp"
 
 MineAlienEntity::MineAlienEntity(float x, float y, int evolution)
@@ -17,18 +15,24 @@ MineAlienEntity::MineAlienEntity(float x, float y, int evolution)
 	}
 }
 
+void* MineAlienEntity::operator new(size_t size) {
+	return SlabPool<MineAlienEntity>::allocate(size);
+}
+
+void MineAlienEntity::operator delete(void* pointer, size_t size) {
+	SlabPool<MineAlienEntity>::deallocate(pointer, size);
+}
+
 bool MineAlienEntity::checkPlacement(Level& level) {
 	return level.checkCollision(this).type == Collision::MISS;
 }
 
 void MineAlienEntity::onDamage(Level& level, int damage, Entity* damager) {
-	bool reduced = false;
-
-	if (BulletEntity* bullet = dynamic_cast<BulletEntity*>(damager)) {
-		if (bullet->isCharged()) reduced = true;
-	}
+	tickExplode(level, false);
+}
 
-	tickExplode(level, reduced);
+void MineAlienEntity::onHit(Level& level, const BulletHit& hit) {
+	tickExplode(level, hit.config.charged);
 }
 
 void MineAlienEntity::onDespawn(Level& level) {
@@ -50,7 +54,7 @@ void MineAlienEntity::tickExplode(Level& level, bool reduced) {
 		float bx = x + radius * cos(angle);
 		float by = y + radius * sin(angle);
 
-		level.addEntity(new BulletEntity{-3, bx, by, self(), (float) M_PI_2 - angle});
+		level.getBullets().spawn(this, -3, bx, by, (float) M_PI_2 - angle);
 	}
 }
 
@@ -59,15 +63,11 @@ void MineAlienEntity::tick(Level& level) {
 
 	this->distance = std::numeric_limits<float>::max();
 
-	for (auto& entity : level.getEntities()) {
-		if (PlayerEntity* player = dynamic_cast<PlayerEntity*>(entity.get())) {
-
-			glm::vec2 target {player->x, player->y};
-			glm::vec2 self {x, y};
+	if (PlayerEntity* player = level.getPlayer()) {
+		glm::vec2 target {player->x, player->y};
+		glm::vec2 self {x, y};
 
-			this->distance = glm::distance(target, self);
-			break;
-		}
+		this->distance = glm::distance(target, self);
 	}
 
 	if (timer) {
@@ -78,7 +78,7 @@ void MineAlienEntity::tick(Level& level) {
 	}
 
 	if (distance < (evolution ? 200 : 150)) {
-		level.addEntity(new BlowEntity(x, y));
+		level.getParticles().blow(x, y);
 		SoundSystem::getInstance().add(Sounds::damage).play();
 		tickExplode(level, false);
 	}
@@ -86,5 +86,5 @@ void MineAlienEntity::tick(Level& level) {
 
 void MineAlienEntity::draw(Level& level, Renderer& renderer) {
 	const int offset = evolution ? 2 : 0;
-	emitEntityQuad(level, *renderer.terrain.writer, renderer.terrain.tileset->sprite(led + offset, 9), size, angle, Color::red(damage_ticks));
+	emitEntityQuad(level, renderer.terrain, renderer.terrain.tileset->cell(led + offset, 9), size, angle, Color::red(damage_ticks));
 }
@@ -16,8 +16,12 @@ class MineAlienEntity : public AlienEntity {
 
 		MineAlienEntity(float x, float y, int evolution);
 
+		static void* operator new(size_t size);
+		static void operator delete(void* pointer, size_t size);
+
 		bool checkPlacement(Level& level) override;
 		void onDamage(Level& level, int damage, Entity* damager) override;
+		void onHit(Level& level, const BulletHit& hit) override;
 		void onDespawn(Level& level) override;
 
 		void tickExplode(Level& level, bool reduced);
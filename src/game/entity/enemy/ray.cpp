@@ -9,12 +9,20 @@
  * RayBeamEntity
  */
 
-RayBeamEntity::RayBeamEntity(const std::shared_ptr<TeslaAlienEntity>& left, const std::shared_ptr<TeslaAlienEntity>& right)
-	: AlienEntity(left->x, left->y, 0), left(left), right(right) {
+RayBeamEntity::RayBeamEntity(TeslaAlienEntity* left, TeslaAlienEntity* right)
+	: AlienEntity(left->x, left->y, 0), left(left->self()), right(right->self()) {
 	this->rx = right->x;
 	this->ry = right->y;
 }
 
+void* RayBeamEntity::operator new(size_t size) {
+	return SlabPool<RayBeamEntity>::allocate(size);
+}
+
+void RayBeamEntity::operator delete(void* pointer, size_t size) {
+	SlabPool<RayBeamEntity>::deallocate(pointer, size);
+}
+
 bool RayBeamEntity::checkPlacement(Level& level) {
 	// if this was to return false only the beam would
 	// be missing, the towers would still be generated
@@ -31,11 +39,20 @@ void RayBeamEntity::tick(Level& level) {
 	Collision collision = level.checkEntityCollision(this);
 
 	if (collision.type == Collision::ENTITY) {
-		if (auto* player = dynamic_cast<PlayerEntity*>(collision.entity)) {
-			player->onDamage(level, 20, this);
+		if (collision.entity->getKind() == EntityKind::PLAYER) {
+			collision.entity->onDamage(level, 20, this);
 		}
 	}
 
+	TeslaAlienEntity* left = level.getEntity<TeslaAlienEntity>(this->left);
+	TeslaAlienEntity* right = level.getEntity<TeslaAlienEntity>(this->right);
+
+	// towers are removed once dead, the beam goes down with them
+	if (left == nullptr || right == nullptr || left->isDead() || right->isDead()) {
+		dead = true;
+		return;
+	}
+
 	// this is mostly just a hack so that we have some position that makes sense
 	// for unloading reasons, it should be named (lx, ly) not (x, y)
 	this->x = left->x;
@@ -46,36 +63,19 @@ void RayBeamEntity::tick(Level& level) {
 
 	this->power = std::max(0.2f, std::min(left->getHealth(), right->getHealth()) / 3.0f);
 	this->collider = Box {20, -10, rx - x - 40, 20};
-
-	if (left->isDead() || right->isDead()) {
-		dead = true;
-	}
 }
 
 void RayBeamEntity::drawElectricArc(RenderLayer& layer, float scroll, int sx, int ex, int ey, float amplitude, float phase, float speed, float roughness, Color color) {
 
-	Sprite sprite = layer.tileset->sprite(0, 0);
-
-	for (int ox = sx; ox < ex; ox ++) {
+	// the whole arc is a single instance, columns are displaced in the shader
+	const float unit = SW / Segment::width;
+	const float shift = std::fmod(age * speed, (float) ArcInstance::period_x);
 
-		// we don't want much movement near the ends, this has maximal value at the center
-		float strength = amplitude * power * std::min(
-			static_cast<float>(std::abs(ox - sx)),
-			static_cast<float>(std::abs(ex - ox))
-		);
-
-		float factor = 10;
-		float slope = 0.5;
-
-		float sigmoidal = factor / (1 + std::pow(M_E, - slope * strength)) - factor / 2;
-
-		int variance = sigmoidal * glm::perlin(glm::vec2 {ox * roughness + age * speed, phase}) + ey;
-		emitTileQuad(*layer.writer, sprite, ox, variance, 0.0f, scroll, color.r, color.g, color.b, color.a);
-	}
+	layer.arc({sx * unit, ey * unit + scroll, (float) (ex - sx), unit, amplitude * power, phase, roughness, shift, layer.tileset->cell(0, 0), color.r, color.g, color.b, color.a});
 }
 
 void RayBeamEntity::draw(Level& level, Renderer& renderer) {
-	auto& writer = *renderer.terrain.writer;
+	auto& layer = renderer.terrain;
 	auto& tileset = *renderer.terrain.tileset;
 
 	glm::ivec2 start = level.toTilePos(x, y);
@@ -83,7 +83,6 @@ void RayBeamEntity::draw(Level& level, Renderer& renderer) {
 
 	float scroll = level.getScroll();
 	int baseline = start.y;
-	const Sprite& sprite = renderer.terrain.tileset->sprite(0, 0);
 
 	// pure red doesn't look that good on it
 	// so we cheat a bit and make it a bluish
@@ -95,7 +94,7 @@ void RayBeamEntity::draw(Level& level, Renderer& renderer) {
 	drawElectricArc(renderer.terrain, scroll, start.x, end.x, baseline, 0.8f, 1.0f, 0.1f, 0.1f, base.withAlpha(120));
 	drawElectricArc(renderer.terrain, scroll, start.x, end.x, baseline, 0.8f, 77.0f, 0.07f, 0.1f, base.withAlpha(120));
 
-	emitTileQuad(writer, tileset.sprite(0, 0), start.x, start.y, 0, scroll, 255, 50, 50, 255);
-	emitTileQuad(writer, tileset.sprite(0, 0), end.x, start.y, 0, scroll, 255, 50, 50, 255);
+	emitTileQuad(layer, tileset.sprite(0, 0), start.x, start.y, 0, scroll, 255, 50, 50, 255);
+	emitTileQuad(layer, tileset.sprite(0, 0), end.x, start.y, 0, scroll, 255, 50, 50, 255);
 
 }
@@ -10,13 +10,16 @@ class RayBeamEntity : public AlienEntity {
 		float ry;
 		float power;
 
-		std::shared_ptr<TeslaAlienEntity> left, right;
+		EntityHandle left, right;
 
 		void drawElectricArc(RenderLayer& layer, float scroll, int sx, int ex, int ey, float amplitude, float phase, float speed, float roughness, Color color);
 
 	public:
 
-		RayBeamEntity(const std::shared_ptr<TeslaAlienEntity>& left, const std::shared_ptr<TeslaAlienEntity>& right);
+		RayBeamEntity(TeslaAlienEntity* left, TeslaAlienEntity* right);
+
+		static void* operator new(size_t size);
+		static void operator delete(void* pointer, size_t size);
 
 		bool checkPlacement(Level& level) override;
 
@@ -1,8 +1,6 @@
 
 #include "sweeper.hpp"
 
-#include "game/entity/bullet.hpp"
-#include "game/entity/particle/blow.hpp"
 #include "game/level/level.hpp"
 #include "game/sounds.hpp"
 
@@ -15,6 +13,14 @@ SweeperAlienEntity::SweeperAlienEntity(double x, double y, int evolution)
 	this->health += 2 + evolution;
 }
 
+void* SweeperAlienEntity::operator new(size_t size) {
+	return SlabPool<SweeperAlienEntity>::allocate(size);
+}
+
+void SweeperAlienEntity::operator delete(void* pointer, size_t size) {
+	SlabPool<SweeperAlienEntity>::deallocate(pointer, size);
+}
+
 bool SweeperAlienEntity::checkPlacement(Level& level) {
 	return level.checkCollision(this).type == Collision::MISS;
 }
@@ -33,6 +39,15 @@ void SweeperAlienEntity::onDamage(Level& level, int damage, Entity* damager) {
 	}
 }
 
+void SweeperAlienEntity::onHit(Level& level, const BulletHit& hit) {
+	AlienEntity::onHit(level, hit);
+
+	// turn around when shot by other aliens
+	if (!hit.player) {
+		facing *= -1;
+	}
+}
+
 void SweeperAlienEntity::tick(Level& level) {
 
 	if (stan_ticks > 0) {
@@ -62,7 +77,7 @@ void SweeperAlienEntity::tick(Level& level) {
 
 		if (buried > 120) {
 			dead = true;
-			level.addEntity(new BlowEntity(x, y));
+			level.getParticles().blow(x, y);
 			SoundSystem::getInstance().add(Sounds::blow).play();
 
 			if (wasAttacked()) {
@@ -95,7 +110,7 @@ void SweeperAlienEntity::tick(Level& level) {
 }
 
 void SweeperAlienEntity::draw(Level& level, Renderer& renderer) {
-	emitEntityQuad(level, *renderer.terrain.writer, renderer.terrain.tileset->sprite(evolution, 5), size, angle + facing * 0.05, Color::red(damage_ticks || (buried % 10 > 5)));
+	emitEntityQuad(level, renderer.terrain, renderer.terrain.tileset->cell(evolution, 5), size, angle + facing * 0.05, Color::red(damage_ticks || (buried % 10 > 5)));
 }
 
 void SweeperAlienEntity::tickShooting(Level& level) {
@@ -105,7 +120,7 @@ void SweeperAlienEntity::tickShooting(Level& level) {
 		bx += (count % 2 == 1 ? -size : size) * 0.3f;
 	}
 
-	level.addEntity(new BulletEntity{-3, bx, y - 24, self(), M_PI});
+	level.getBullets().spawn(this, -3, bx, y - 24, M_PI);
 }
 
 void SweeperAlienEntity::tickMovement() {
@@ -15,10 +15,14 @@ class SweeperAlienEntity : public AlienEntity {
 
 		SweeperAlienEntity(double x, double y, int evolution);
 
+		static void* operator new(size_t size);
+		static void operator delete(void* pointer, size_t size);
+
 		bool checkPlacement(Level& level) override;
 
 		void onDamaged(Level& level) override;
 		void onDamage(Level& level, int damage, Entity* damager) override;
+		void onHit(Level& level, const BulletHit& hit) override;
 
 		void tick(Level& level) override;
 		void draw(Level& level, Renderer& renderer) override;
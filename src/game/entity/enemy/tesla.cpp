@@ -13,11 +13,13 @@ bool TeslaAlienEntity::spawnAt(Level& level, int lx, int rx, int y, int evolutio
 	glm::vec2 lp = Level::toEntityPos(lx, y);
 	glm::vec2 rp = Level::toEntityPos(rx, y);
 
-	std::shared_ptr<TeslaAlienEntity> left = std::make_shared<TeslaAlienEntity>(lp.x, lp.y, evolution, LEFT);
-	std::shared_ptr<TeslaAlienEntity> right = std::make_shared<TeslaAlienEntity>(rp.x, rp.y, evolution, RIGHT);
+	TeslaAlienEntity* left = new TeslaAlienEntity {lp.x, lp.y, evolution, LEFT};
+	TeslaAlienEntity* right = new TeslaAlienEntity {rp.x, rp.y, evolution, RIGHT};
 
 	// manually check placement so that both need to match first
 	if (!left->checkPlacement(level) || !right->checkPlacement(level)){
+		delete left;
+		delete right;
 		return false;
 	}
 
@@ -102,6 +104,14 @@ TeslaAlienEntity::TeslaAlienEntity(double x, double y, int evolution, Side side)
 	}
 }
 
+void* TeslaAlienEntity::operator new(size_t size) {
+	return SlabPool<TeslaAlienEntity>::allocate(size);
+}
+
+void TeslaAlienEntity::operator delete(void* pointer, size_t size) {
+	SlabPool<TeslaAlienEntity>::deallocate(pointer, size);
+}
+
 bool TeslaAlienEntity::checkPlacement(Level& level) {
 	return level.checkEntityCollision(this).type == Collision::MISS;
 }
@@ -118,7 +128,7 @@ void TeslaAlienEntity::tick(Level& level) {
 void TeslaAlienEntity::draw(Level& level, Renderer& renderer) {
 	const Color color = Color::red(damage_ticks);
 
-	emitEntityQuad(level, *renderer.terrain.writer, renderer.terrain.tileset->sprite(1, 13), size, angle, color);
+	emitEntityQuad(level, renderer.terrain, renderer.terrain.tileset->cell(1, 13), size, angle, color);
 }
 
 void TeslaAlienEntity::onSpawned(const Level& level, Segment* segment) {
@@ -19,6 +19,9 @@ class TeslaAlienEntity : public AlienEntity {
 
 		TeslaAlienEntity(double x, double y, int evolution, Side side);
 
+		static void* operator new(size_t size);
+		static void operator delete(void* pointer, size_t size);
+
 		bool checkPlacement(Level& level) override;
 
 		void tick(Level& level) override;
@@ -1,8 +1,6 @@
 
 #include "turret.hpp"
 
-#include "game/entity/bullet.hpp"
-#include "game/entity/particle/dust.hpp"
 #include "game/level/level.hpp"
 #include "game/level/matcher.hpp"
 
@@ -47,6 +45,14 @@ TurretAlienEntity::TurretAlienEntity(double x, double y, int evolution)
 	: AlienEntity(x, y, evolution) {
 }
 
+void* TurretAlienEntity::operator new(size_t size) {
+	return SlabPool<TurretAlienEntity>::allocate(size);
+}
+
+void TurretAlienEntity::operator delete(void* pointer, size_t size) {
+	SlabPool<TurretAlienEntity>::deallocate(pointer, size);
+}
+
 bool TurretAlienEntity::checkPlacement(Level& level) {
 	return level.checkEntityCollision(this).type == Collision::MISS;
 }
@@ -61,11 +67,11 @@ void TurretAlienEntity::shoot(Level& level, float speed, float radius, float off
 	float effect = radius - 8;
 
 	// create bullet
-	level.addEntity(new BulletEntity {-speed, x + radius * ax, y + radius * ay, self(), head});
+	level.getBullets().spawn(this, -speed, x + radius * ax, y + radius * ay, head);
 
 	// particle effect
 	for (int i = randomInt(2, 5); i > 0; i--) {
-		level.addEntity(new DustEntity {x + effect * ax, y + effect * ay, ax, ay, head, 1, 0.5, 20, Color::red()});
+		level.getParticles().dust(x + effect * ax, y + effect * ay, ax, ay, head, 1, 0.5, 20, Color::red());
 	}
 
 }
@@ -73,7 +79,7 @@ void TurretAlienEntity::shoot(Level& level, float speed, float radius, float off
 void TurretAlienEntity::tick(Level& level) {
 	AlienEntity::tick(level);
 
-	if (std::shared_ptr<PlayerEntity> player = level.getPlayer()) {
+	if (PlayerEntity* player = level.getPlayer()) {
 		glm::vec2 dir {player->x - x, player->y - y};
 		float bullet = 5;
 		float radius = 32;
@@ -107,8 +113,8 @@ void TurretAlienEntity::tick(Level& level) {
 void TurretAlienEntity::draw(Level& level, Renderer& renderer) {
 	const Color color = Color::red(damage_ticks);
 
-	emitEntityQuad(level, *renderer.terrain.writer, renderer.terrain.tileset->sprite(0, 6), size, angle, color);
-	emitEntityQuad(level, *renderer.terrain.writer, renderer.terrain.tileset->sprite(evolution + 1, 6), size, head, color);
+	emitEntityQuad(level, renderer.terrain, renderer.terrain.tileset->cell(0, 6), size, angle, color);
+	emitEntityQuad(level, renderer.terrain, renderer.terrain.tileset->cell(evolution + 1, 6), size, head, color);
 }
 
 void TurretAlienEntity::onSpawned(const Level& level, Segment* segment) {
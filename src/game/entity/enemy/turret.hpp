@@ -16,6 +16,9 @@ class TurretAlienEntity : public AlienEntity {
 
 		TurretAlienEntity(double x, double y, int evolution);
 
+		static void* operator new(size_t size);
+		static void operator delete(void* pointer, size_t size);
+
 		bool checkPlacement(Level& level) override;
 
 		void tick(Level& level) override;
@@ -2,7 +2,6 @@
 #include "vertical.hpp"
 
 #include "game/level/level.hpp"
-#include "game/entity/bullet.hpp"
 
 /*
  * VerticalAlienEntity
@@ -19,6 +18,14 @@ VerticalAlienEntity::VerticalAlienEntity(double x, double y, int evolution)
 	this->active = false;
 }
 
+void* VerticalAlienEntity::operator new(size_t size) {
+	return SlabPool<VerticalAlienEntity>::allocate(size);
+}
+
+void VerticalAlienEntity::operator delete(void* pointer, size_t size) {
+	SlabPool<VerticalAlienEntity>::deallocate(pointer, size);
+}
+
 void VerticalAlienEntity::tick(Level& level) {
 
 	if (stan_ticks > 0) {
@@ -29,13 +36,12 @@ void VerticalAlienEntity::tick(Level& level) {
 
 	this->active = false;
 
-	for (auto& entity : level.getEntities()) {
-		if (entity->getBoxCollider().intersects(getBoxTrigger())) {
-			if (entity->isCausedByPlayer()) {
-				this->active = true;
-				break;
-			}
-		}
+	if (PlayerEntity* player = level.getPlayer(); player && player->getBoxCollider().intersects(getBoxTrigger())) {
+		this->active = true;
+	}
+
+	if (level.getBullets().overlaps(getBoxTrigger(), true)) {
+		this->active = true;
 	}
 
 	if (active && (age % 30 == 0)) {
@@ -45,15 +51,15 @@ void VerticalAlienEntity::tick(Level& level) {
 			bx += (count % 2 == 1 ? -size : size) * 0.3f;
 		}
 
-		level.addEntity(new BulletEntity{-3, bx, y - 24, self(), M_PI});
+		level.getBullets().spawn(this, -3, bx, y - 24, M_PI);
 	}
 
 	SweeperAlienEntity::tick(level);
 }
 
 void VerticalAlienEntity::draw(Level& level, Renderer& renderer) {
-	Sprite sprite = renderer.terrain.tileset->sprite(evolution, 8);
-	emitEntityQuad(level, *renderer.terrain.writer, sprite, size, angle, Color::red(damage_ticks || (buried % 10 > 5)));
+	uint32_t sprite = renderer.terrain.tileset->cell(evolution, 8);
+	emitEntityQuad(level, renderer.terrain, sprite, size, angle, Color::red(damage_ticks || (buried % 10 > 5)));
 }
 
 inline void VerticalAlienEntity::debugDraw(Level& level, Renderer& renderer) {
@@ -67,6 +73,6 @@ void VerticalAlienEntity::tickMovement() {
 }
 
 void VerticalAlienEntity::tickShooting(Level& level) {
-	level.addEntity(new BulletEntity{-3, x + 32, y, self(), + M_PI_2});
-	level.addEntity(new BulletEntity{-3, x - 32, y, self(), - M_PI_2});
+	level.getBullets().spawn(this, -3, x + 32, y, + M_PI_2);
+	level.getBullets().spawn(this, -3, x - 32, y, - M_PI_2);
 }
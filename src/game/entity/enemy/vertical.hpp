@@ -16,6 +16,9 @@ class VerticalAlienEntity : public SweeperAlienEntity {
 
 		VerticalAlienEntity(double x, double y, int evolution);
 
+		static void* operator new(size_t size);
+		static void operator delete(void* pointer, size_t size);
+
 		void tick(Level& level) override;
 		void draw(Level& level, Renderer& renderer) override;
 		void debugDraw(Level& level, Renderer& renderer) override;
@@ -10,23 +10,39 @@
  * Entity
  */
 
-void Entity::emitEntityQuad(Level& level, BufferWriter<Vert4f4b>& writer, Sprite sprite, float size, float angle, Color color) const {
-	emitSpriteQuad(writer, x, y + level.getScroll(), size, size, angle, sprite, color.r, color.g, color.b, color.a);
+void Entity::emitEntityQuad(Level& level, RenderLayer& layer, uint32_t sprite, float size, float angle, Color color) const {
+	emitSprite(layer, x, y + level.getScroll(), size, size, angle, sprite, color.r, color.g, color.b, color.a);
 }
 
 void Entity::emitBoxWireframe(Box box, RenderLayer& layer, float width, Color color) const {
-	Sprite sprite = layer.tileset->sprite(0, 0);
+	const Sprite& sprite = layer.tileset->sprite(0, 0);
 
-	emitLineQuad(*layer.writer, box.x, box.y, box.x, box.y + box.h, width, sprite, color.r, color.g, color.b, color.a);
-	emitLineQuad(*layer.writer, box.x, box.y, box.x + box.w, box.y, width, sprite, color.r, color.g, color.b, color.a);
-	emitLineQuad(*layer.writer, box.x + box.w, box.y, box.x + box.w, box.y + box.h, width, sprite, color.r, color.g, color.b, color.a);
-	emitLineQuad(*layer.writer, box.x, box.y + box.h, box.x + box.w, box.y + box.h, width, sprite, color.r, color.g, color.b, color.a);
+	emitLineQuad(layer, box.x, box.y, box.x, box.y + box.h, width, sprite, color.r, color.g, color.b, color.a);
+	emitLineQuad(layer, box.x, box.y, box.x + box.w, box.y, width, sprite, color.r, color.g, color.b, color.a);
+	emitLineQuad(layer, box.x + box.w, box.y, box.x + box.w, box.y + box.h, width, sprite, color.r, color.g, color.b, color.a);
+	emitLineQuad(layer, box.x, box.y + box.h, box.x + box.w, box.y + box.h, width, sprite, color.r, color.g, color.b, color.a);
 }
 
 float Entity::getAngle() const {
 	return angle;
 }
 
+EntityKind Entity::getKind() const {
+	return kind;
+}
+
+CollisionLayer Entity::getCollisionLayer() const {
+	return layer;
+}
+
+CollisionMask Entity::getCollisionMask() const {
+	return mask;
+}
+
+bool Entity::canCollide(const Entity& other) const {
+	return (mask & maskOf(other.layer)) && (other.mask & maskOf(layer));
+}
+
 Entity::Entity(float size, float x, float y)
 : size(size) {
 	this->x = x;
@@ -36,6 +52,14 @@ Entity::Entity(float size, float x, float y)
 
 Entity::~Entity() {}
 
+void* Entity::operator new(size_t size) {
+	return SlabAllocator::allocate(size);
+}
+
+void Entity::operator delete(void* pointer, size_t size) {
+	SlabAllocator::deallocate(pointer, size);
+}
+
 bool Entity::shouldRemove() const {
 	return dead;
 }
@@ -51,7 +75,7 @@ void Entity::clamp() {
 }
 
 void Entity::debugDraw(Level& level, Renderer& renderer) {
-	emitBoxWireframe(getBoxCollider().withOffset(0, level.getScroll()), renderer.terrain, 1, Color::white());
+	emitBoxWireframe(getBoxCollider().withOffset(0, level.getScroll()), renderer.debug, 1, Color::white());
 }
 
 void Entity::onSpawned(const Level& level, NULLABLE Segment* segment) {
@@ -80,8 +104,12 @@ bool Entity::isCausedByPlayer() {
 	return false;
 }
 
-std::shared_ptr<Entity> Entity::getParent() {
-	return nullptr;
+void Entity::onHit(Level& level, const BulletHit& hit) {
+	onDamage(level, 1, hit.shooter);
+}
+
+bool Entity::isIntangible() const {
+	return false;
 }
 
 void Entity::tick(Level& level) {
@@ -100,8 +128,8 @@ void Entity::tick(Level& level) {
 	age += 1;
 }
 
-std::shared_ptr<Entity> Entity::self() {
-	return shared_from_this();
+EntityHandle Entity::self() const {
+	return handle;
 }
 
 Box Entity::getBoxCollider() const {
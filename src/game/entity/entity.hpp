@@ -3,15 +3,57 @@
 #include "external.hpp"
 #include "game/color.hpp"
 #include "game/level/box.hpp"
+#include "handle.hpp"
 #include "render/renderer.hpp"
+#include "util/slab.hpp"
 
 class Level;
 class Segment;
+struct BulletHit;
+
+/// Entity classes the level keeps a registry of, so they can be found without scanning all entities
+enum struct EntityKind : uint8_t {
+	GENERIC = 0,
+	PLAYER  = 1,
+	FIGHTER = 2,
+	POWERUP = 3,
+	COUNT   = 4,
+};
+
+/// Collision group an entity belongs to, entities only collide when each one's mask contains the other's layer
+enum struct CollisionLayer : uint8_t {
+	PLAYER        = 0, // the player and their shield
+	PLAYER_BULLET = 1,
+	ENEMY         = 2,
+	ENEMY_BULLET  = 3,
+	PICKUP        = 4,
+	DECOR         = 5, // never collides, not even inserted into the collision structures
+};
+
+/// Set of collision layers, one bit per layer
+using CollisionMask = uint8_t;
+
+/// Get the mask with just the given layers set
+template <typename... L>
+constexpr CollisionMask maskOf(L... layers) {
+	return ((CollisionMask) (1 << (int) layers) | ... | 0);
+}
+
+class Entity {
 
-class Entity : public std::enable_shared_from_this<Entity> {
+	private:
+
+		// assigned by the level once the entity is added
+		friend class Level;
+		EntityHandle handle;
 
 	protected:
 
+		// set in the constructor, they must not change once the entity is added to the level
+		EntityKind kind = EntityKind::GENERIC;
+		CollisionLayer layer = CollisionLayer::DECOR;
+		CollisionMask mask = 0;
+
 		float angle = 0;
 
 		bool visible = false;
@@ -20,7 +62,7 @@ class Entity : public std::enable_shared_from_this<Entity> {
 		Box collider;
 		float size;
 
-		void emitEntityQuad(Level& level, BufferWriter<Vert4f4b>& writer, Sprite sprite, float size, float angle, Color color) const;
+		void emitEntityQuad(Level& level, RenderLayer& layer, uint32_t sprite, float size, float angle, Color color) const;
 		void emitBoxWireframe(Box box, RenderLayer& layer, float width, Color color) const;
 
 	public:
@@ -32,24 +74,42 @@ class Entity : public std::enable_shared_from_this<Entity> {
 
 		Entity(float size, float x, float y);
 		virtual ~Entity();
+
+		/// Entities are carved out of slabs, so spawning them doesn't touch the heap, each concrete
+		/// type declares its own operators backed by a SlabPool, types that don't share slabs by size class
+		static void* operator new(size_t size);
+		static void operator delete(void* pointer, size_t size);
 		void clamp();
 
 		float getAngle() const;
+		EntityKind getKind() const;
+		CollisionLayer getCollisionLayer() const;
+		CollisionMask getCollisionMask() const;
+
+		/// Check if the layers and masks of both entities allow them to collide
+		bool canCollide(const Entity& other) const;
 
 		bool shouldRemove() const;
-		std::shared_ptr<Entity> self();
+		/// Get the handle of this entity, only valid once it was added to the level
+		EntityHandle self() const;
 		Box getBoxCollider() const;
 
 		bool isDead() const;
 
 	public:
 
-		/// Invoked to check for collision between this and the given entity
+		/// Invoked to check for collision between this and the given entity, only called if canCollide() allows it
 		virtual bool shouldCollide(Entity* entity);
 
 		/// Used when something deals damage to the entity
 		virtual void onDamage(Level& level, int damage, NULLABLE Entity* damager);
 
+		/// Used when a bullet hits the entity, by default it deals damage on behalf of the shooter
+		virtual void onHit(Level& level, const BulletHit& hit);
+
+		/// Intangible entities are skipped by bullets and most collisions
+		virtual bool isIntangible() const;
+
 		/// invoked every tick to update the entity state
 		virtual void tick(Level& level);
 
@@ -67,7 +127,6 @@ class Entity : public std::enable_shared_from_this<Entity> {
 
 		virtual bool checkPlacement(Level& level);
 		virtual bool isCausedByPlayer();
-		virtual std::shared_ptr<Entity> getParent();
 
 };
 
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "external.hpp"
+
+class Entity;
+
+/// Weak reference to an entity, resolves to null once the entity is removed and its slot reused
+struct EntityHandle {
+
+	static constexpr uint32_t index_bits = 20;
+	static constexpr uint32_t index_mask = (1 << index_bits) - 1;
+	static constexpr uint32_t generation_mask = (1 << (32 - index_bits)) - 1;
+
+	// generation is kept in the upper bits, zero is never a valid generation
+	uint32_t value = 0;
+
+	uint32_t index() const {
+		return value & index_mask;
+	}
+
+	uint32_t generation() const {
+		return value >> index_bits;
+	}
+
+	explicit operator bool() const {
+		return value != 0;
+	}
+
+	bool operator ==(const EntityHandle& other) const = default;
+
+	static EntityHandle of(uint32_t index, uint32_t generation) {
+		return {(generation << index_bits) | index};
+	}
+
+};
+
+/// Maps entity handles to live entities, slots of removed entities are recycled with a new generation
+class EntityTable {
+
+	private:
+
+		struct Slot {
+			Entity* entity = nullptr;
+			uint32_t generation = 0;
+		};
+
+		std::vector<Slot> slots;
+		std::vector<uint32_t> free;
+
+	public:
+
+		/// Register an entity and get a handle that refers to it
+		EntityHandle insert(Entity* entity) {
+			uint32_t index;
+
+			if (free.empty()) {
+				index = slots.size();
+
+				if (index > EntityHandle::index_mask) {
+					fault("Entity table is full, too many entities (%d)!\n", (int) index);
+				}
+
+				slots.emplace_back();
+			} else {
+				index = free.back();
+				free.pop_back();
+			}
+
+			Slot& slot = slots[index];
+			slot.entity = entity;
+
+			// skip generation zero, so that a default constructed handle never matches a slot
+			slot.generation = (slot.generation + 1) & EntityHandle::generation_mask;
+			slot.generation += (slot.generation == 0);
+
+			return EntityHandle::of(index, slot.generation);
+		}
+
+		/// Unregister an entity, all handles referring to it will resolve to null
+		void remove(EntityHandle handle) {
+			if (get(handle) != nullptr) {
+				slots[handle.index()].entity = nullptr;
+				free.push_back(handle.index());
+			}
+		}
+
+		/// Get the entity the handle refers to, or null if it was removed
+		NULLABLE Entity* get(EntityHandle handle) const {
+			const uint32_t index = handle.index();
+
+			if (index >= slots.size() || slots[index].generation != handle.generation()) {
+				return nullptr;
+			}
+
+			return slots[index].entity;
+		}
+
+};
@@ -1,8 +1,6 @@
 
 #include "player.hpp"
 
-#include "bullet.hpp"
-#include "particle/dust.hpp"
 #include "powerup.hpp"
 #include "shield.hpp"
 #include "game/level/level.hpp"
@@ -29,6 +27,17 @@ PlayerEntity::PlayerEntity()
 : Entity(64, SW / 2, 0) {
 	this->bumper = Box(-5, -32, 10, 64);
 	this->collider = Box {-24, -24, 48, 48};
+	this->kind = EntityKind::PLAYER;
+	this->layer = CollisionLayer::PLAYER;
+	this->mask = maskOf(CollisionLayer::ENEMY, CollisionLayer::ENEMY_BULLET, CollisionLayer::PICKUP);
+}
+
+void* PlayerEntity::operator new(size_t size) {
+	return SlabPool<PlayerEntity>::allocate(size);
+}
+
+void PlayerEntity::operator delete(void* pointer, size_t size) {
+	SlabPool<PlayerEntity>::deallocate(pointer, size);
 }
 
 bool PlayerEntity::isCausedByPlayer() {
@@ -36,13 +45,17 @@ bool PlayerEntity::isCausedByPlayer() {
 }
 
 bool PlayerEntity::shouldCollide(Entity* entity) {
-	if ((invulnerable > 0) && !dynamic_cast<PowerUpEntity*>(entity)) {
+	if (isIntangible() && (entity->getKind() != EntityKind::POWERUP)) {
 		return false;
 	}
 
 	return Entity::shouldCollide(entity);
 }
 
+bool PlayerEntity::isIntangible() const {
+	return invulnerable > 0;
+}
+
 void PlayerEntity::onDamage(Level& level, int damage, Entity* damager) {
 	if (damage > 0) {
 		if (level.isDebug()) {
@@ -58,7 +71,7 @@ void PlayerEntity::onDamage(Level& level, int damage, Entity* damager) {
 				for (int i = randomInt(50, 80); i > 0; i--) {
 					int brightness = randomInt(50, 100);
 					Color color = Color::of(brightness, brightness, 255);
-					level.addEntity(new DustEntity {x, y, randomFloat(-1, 1), randomFloat(-1, 1), 1, 1, 1, 60, color});
+					level.getParticles().dust(x, y, randomFloat(-1, 1), randomFloat(-1, 1), 1, 1, 1, 60, color);
 				}
 			}
 
@@ -81,10 +94,6 @@ void PlayerEntity::onDamage(Level& level, int damage, Entity* damager) {
 
 void PlayerEntity::tick(Level& level) {
 
-	if (shield && shield->shouldRemove()) {
-		shield.reset();
-	}
-
 	int avoidance = 0;
 
 	// regenerate ammo
@@ -100,7 +109,7 @@ void PlayerEntity::tick(Level& level) {
 		float spread = randomFloat(-10, 10);
 		int brightness = randomInt(50, 100);
 		Color color = Color::of(brightness, brightness, 255);
-		level.addEntity(new DustEntity(x + spread, y - 42, 0, -1, 0, 1, 2, 20, color));
+		level.getParticles().dust(x + spread, y - 42, 0, -1, 0, 1, 2, 20, color);
 	}
 
 	if (invulnerable == 0) {
@@ -171,14 +180,14 @@ void PlayerEntity::tick(Level& level) {
 		}
 
 		if (double_barrel_ticks > 0) {
-			level.addEntity(new BulletEntity {-11, x - 32, y + 30, self(), 0, config});
-			level.addEntity(new BulletEntity {-11, x + 32, y + 30, self(), 0, config});
+			level.getBullets().spawn(this, -11, x - 32, y + 30, 0, config);
+			level.getBullets().spawn(this, -11, x + 32, y + 30, 0, config);
 			double_barrel_ticks --;
 			shot = true;
 		} else {
 			if (ammo > 0) {
 				ammo --;
-				level.addEntity(new BulletEntity {-11, x, y + 48, self(), 0, config});
+				level.getBullets().spawn(this, -11, x, y + 48, 0, config);
 				shot = true;
 			}
 		}
@@ -201,49 +210,65 @@ void PlayerEntity::tick(Level& level) {
 void PlayerEntity::draw(Level& level, Renderer& renderer) {
 
 	auto& layer = renderer.terrain;
-	auto& writer = *layer.writer;
+	auto& hud = renderer.hud;
 	auto& tileset = *layer.tileset;
 
-	Sprite sprite = tileset.sprite(2, 0);
+	uint32_t sprite = tileset.cell(2, 0);
 
 	if (invulnerable > 0) {
-		sprite = tileset.sprite(3 - (invulnerable & 0b1000 ? 1 : 0), 0);
+		sprite = tileset.cell(3 - (invulnerable & 0b1000 ? 1 : 0), 0);
 	}
 
 	const float vert = size + level.getSkip() * 8;
 	Color c = Color::white().withAlpha(invulnerable > 0 ? 180 : 255);
-	emitSpriteQuad(writer, x, y + level.getScroll(), size, vert, angle, sprite, c.r, c.g, c.b, c.a);
+	emitSprite(layer, x, y + level.getScroll(), size, vert, angle, sprite, c.r, c.g, c.b, c.a);
 
+	if (lives != hud_lives || ammo != hud_ammo || &tileset != hud_tileset) {
+		buildHud(tileset);
+	}
+
+	hud.sprites(hud_mesh);
+}
+
+void PlayerEntity::buildHud(const TileSet& tileset) {
 	int pack = 8;
 	int magazines = ammo / pack;
 	int modulo = ammo % pack;
 	int unit = 255 / pack * modulo;
 
+	hud_mesh.clear();
+
 	for (int i = 0; i < lives; i ++) {
-		emitSpriteQuad(writer, 32 + i * 48, SH - 32, 32, 32, 0, tileset.sprite(0, 1), 255, 255, 255, 220);
+		hud_mesh.emplace_back(32 + i * 48, SH - 32, 32, 32, 0, tileset.cell(0, 1), 255, 255, 255, 220);
 	}
 
 	for (int i = 0; i < magazines; i ++) {
-		emitSpriteQuad(writer, 16 + i * 16, 16, 6, 6, 0, tileset.sprite(0, 0), 155, 155, 255, 220);
+		hud_mesh.emplace_back(16 + i * 16, 16, 6, 6, 0, tileset.cell(0, 0), 155, 155, 255, 220);
 	}
 
 	if (modulo) {
-		emitSpriteQuad(writer, 16 + magazines * 16, 16, 6, 6, 0, tileset.sprite(0, 0), 155, 155, 255, unit);
+		hud_mesh.emplace_back(16 + magazines * 16, 16, 6, 6, 0, tileset.cell(0, 0), 155, 155, 255, unit);
 	}
+
+	hud_tileset = &tileset;
+	hud_lives = lives;
+	hud_ammo = ammo;
 }
 
 void PlayerEntity::debugDraw(Level& level, Renderer& renderer) {
 	Entity::debugDraw(level, renderer);
 
-	auto& layer = renderer.terrain;
+	auto& layer = renderer.debug;
 	emitBoxWireframe(getBoxBumper(-1).withOffset(0, level.getScroll()), layer, 1, Color::white());
 	emitBoxWireframe(getBoxBumper(+1).withOffset(0, level.getScroll()), layer, 1, Color::white());
 }
 
 void PlayerEntity::enableShield(Level& level) {
-	if (shield) {
-		shield->repower();
+	ShieldEntity* current = level.getEntity<ShieldEntity>(shield);
+
+	if (current && !current->shouldRemove()) {
+		current->repower();
 	} else {
-		shield = level.addEntity(new ShieldEntity(std::static_pointer_cast<PlayerEntity>(self())));
+		shield = level.addEntity(new ShieldEntity(this))->self();
 	}
 }
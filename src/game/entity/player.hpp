@@ -17,7 +17,15 @@ class PlayerEntity : public Entity {
 		int thruster_sound_timeout = 0;
 		Box bumper;
 
-		std::shared_ptr<ShieldEntity> shield = nullptr;
+		EntityHandle shield;
+
+		// retained lives and ammo indicators, rebuilt only when the values they show change
+		std::vector<SpriteInstance> hud_mesh;
+		NULLABLE const TileSet* hud_tileset = nullptr;
+		int hud_lives = -1;
+		int hud_ammo = -1;
+
+		void buildHud(const TileSet& tileset);
 
 		/// get the left (side == -1) or right (side == +1) bumper box
 		Box getBoxBumper(int side) const;
@@ -36,10 +44,14 @@ class PlayerEntity : public Entity {
 
 		PlayerEntity();
 
+		static void* operator new(size_t size);
+		static void operator delete(void* pointer, size_t size);
+
 		bool shouldCollide(Entity* entity) override;
 
 		bool isCausedByPlayer() override;
 		void onDamage(Level& level, int damage, Entity* damager) override;
+		bool isIntangible() const override;
 		void tick(Level& level) override;
 		void draw(Level& level, Renderer& renderer) override;
 		void debugDraw(Level& level, Renderer& renderer) override;
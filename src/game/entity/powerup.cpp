@@ -2,10 +2,8 @@
 #include "powerup.hpp"
 
 #include "player.hpp"
-#include "particle/blow.hpp"
 #include "game/level/level.hpp"
 #include "game/sounds.hpp"
-#include "particle/text.hpp"
 
 /*
  * PowerUpEntity
@@ -25,7 +23,17 @@ PowerUpEntity::Type PowerUpEntity::randomPick() {
 
 PowerUpEntity::PowerUpEntity(double x, double y, Type type)
 : Entity(32, x, y), type(type) {
+	this->kind = EntityKind::POWERUP;
+	this->layer = CollisionLayer::PICKUP;
+	this->mask = maskOf(CollisionLayer::PLAYER, CollisionLayer::PLAYER_BULLET);
+}
+
+void* PowerUpEntity::operator new(size_t size) {
+	return SlabPool<PowerUpEntity>::allocate(size);
+}
 
+void PowerUpEntity::operator delete(void* pointer, size_t size) {
+	SlabPool<PowerUpEntity>::deallocate(pointer, size);
 }
 
 bool PowerUpEntity::checkPlacement(Level& level) {
@@ -35,42 +43,42 @@ bool PowerUpEntity::checkPlacement(Level& level) {
 void PowerUpEntity::applyEffect(Level& level, PlayerEntity* player) {
 	if (type == LIVE) {
 		player->onDamage(level, -10, this);
-		level.addEntity(new TextEntity {x, y, "Extra Life", 30});
+		level.getParticles().text(x, y, "Extra Life", 30);
 	}
 
 	if (type == DOUBLE_BARREL) {
 		player->double_barrel_ticks += 50;
-		level.addEntity(new TextEntity {x, y, "Double Barrel", 30});
+		level.getParticles().text(x, y, "Double Barrel", 30);
 	}
 
 	if (type == SHIELD) {
 		player->enableShield(level);
-		level.addEntity(new TextEntity {x, y, "Shield", 30});
+		level.getParticles().text(x, y, "Shield", 30);
 	}
 
 	if (type == NITRO) {
 		player->nitro_ticks += 8 * 60;
-		level.addEntity(new TextEntity {x, y, "Nitro Charge", 30});
+		level.getParticles().text(x, y, "Nitro Charge", 30);
 	}
 
 	if (type == STAN) {
 		player->charged_ammo += 20;
-		level.addEntity(new TextEntity {x, y, "Charged Bullets", 30});
+		level.getParticles().text(x, y, "Charged Bullets", 30);
 	}
 
 	if (type == PIERCE) {
 		player->piercing_ammo += 20;
-		level.addEntity(new TextEntity {x, y, "Piercing Bullets", 30});
+		level.getParticles().text(x, y, "Piercing Bullets", 30);
 	}
 }
 
 void PowerUpEntity::onDamage(Level& level, int damage, Entity* damager) {
-	if (damager->isCausedByPlayer() && visible) {
-		std::shared_ptr<Entity> parent = damager->getParent();
+	if (damager && damager->isCausedByPlayer() && visible) {
 		SoundSystem::getInstance().add(Sounds::coin).play();
 
-		if (!dead && parent) {
-			applyEffect(level, dynamic_cast<PlayerEntity*>(parent.get()));
+		// shot by the player, bullets pass their shooter as the damager
+		if (!dead && damager->getKind() == EntityKind::PLAYER) {
+			applyEffect(level, static_cast<PlayerEntity*>(damager));
 			dead = true;
 		}
 
@@ -84,8 +92,9 @@ void PowerUpEntity::tick(Level& level) {
 	Collision collision = level.checkCollision(this);
 
 	if (!dead && (collision.type == Collision::ENTITY)) {
-		if (PlayerEntity* player = dynamic_cast<PlayerEntity*>(collision.entity)) {
-			level.addEntity(new BlowEntity(x, y));
+		if (collision.entity->getKind() == EntityKind::PLAYER) {
+			PlayerEntity* player = static_cast<PlayerEntity*>(collision.entity);
+			level.getParticles().blow(x, y);
 			SoundSystem::getInstance().add(Sounds::coin).play();
 
 			applyEffect(level, player);
@@ -97,6 +106,6 @@ void PowerUpEntity::tick(Level& level) {
 }
 
 void PowerUpEntity::draw(Level& level, Renderer& renderer) {
-	emitEntityQuad(level, *renderer.terrain.writer, renderer.terrain.tileset->sprite(7, 4), size + 4 * sin(age * 0.1), 0, Color::white().withAlpha(180));
-	emitEntityQuad(level, *renderer.terrain.writer, renderer.terrain.tileset->sprite(type, 1), size , angle, Color::white());
+	emitEntityQuad(level, renderer.terrain, renderer.terrain.tileset->cell(7, 4), size + 4 * sin(age * 0.1), 0, Color::white().withAlpha(180));
+	emitEntityQuad(level, renderer.terrain, renderer.terrain.tileset->cell(type, 1), size , angle, Color::white());
 }
@@ -27,6 +27,9 @@ class PowerUpEntity : public Entity {
 
 		PowerUpEntity(double x, double y, Type type);
 
+		static void* operator new(size_t size);
+		static void operator delete(void* pointer, size_t size);
+
 		bool checkPlacement(Level& level) override;
 
 		void applyEffect(Level& level, PlayerEntity* player);
@@ -1,7 +1,6 @@
 
 #include "shield.hpp"
 
-#include "bullet.hpp"
 #include "player.hpp"
 #include "game/emitter.hpp"
 #include "game/level/level.hpp"
@@ -10,24 +9,29 @@
  * ShieldEntity
  */
 
-ShieldEntity::ShieldEntity(const std::shared_ptr <PlayerEntity>& player)
-: player(player), Entity(32, 0, 0) {
-	updatePosition();
+ShieldEntity::ShieldEntity(PlayerEntity* player)
+: Entity(32, 0, 0), player(player->self()) {
+	updatePosition(*player);
 	repower();
 	this->collider = Box {-32, -16, 64, 32};
+
+	// sharing the layer of the player keeps both the player and their bullets out
+	this->layer = CollisionLayer::PLAYER;
+	this->mask = maskOf(CollisionLayer::ENEMY, CollisionLayer::ENEMY_BULLET);
 }
 
-bool ShieldEntity::shouldCollide(Entity* entity) {
-	if (entity->isCausedByPlayer()) {
-		return false;
-	}
+void* ShieldEntity::operator new(size_t size) {
+	return SlabPool<ShieldEntity>::allocate(size);
+}
 
-	return Entity::shouldCollide(entity);
+void ShieldEntity::operator delete(void* pointer, size_t size) {
+	SlabPool<ShieldEntity>::deallocate(pointer, size);
 }
 
-void ShieldEntity::updatePosition() {
-	this->x = player->x;
-	this->y = player->y + 48 + (age % 60 / 20) * 2;
+void ShieldEntity::updatePosition(PlayerEntity& player) {
+	this->x = player.x;
+	this->y = player.y + 48 + (age % 60 / 20) * 2;
+	this->tilt = player.getAngle();
 }
 
 void ShieldEntity::onDamage(Level& level, int damage, Entity* damager) {
@@ -42,9 +46,10 @@ void ShieldEntity::onDamage(Level& level, int damage, Entity* damager) {
 
 void ShieldEntity::tick(Level& level) {
 	Entity::tick(level);
-	updatePosition();
 
-	if (player->isDead()) {
+	if (PlayerEntity* pointer = level.getEntity<PlayerEntity>(player); pointer && !pointer->isDead()) {
+		updatePosition(*pointer);
+	} else {
 		dead = true;
 	}
 
@@ -58,13 +63,13 @@ void ShieldEntity::tick(Level& level) {
 }
 
 void ShieldEntity::draw(Level& level, Renderer& renderer) {
-	auto& writer = *renderer.terrain.writer;
+	auto& layer = renderer.terrain;
 	auto& tileset = *renderer.terrain.tileset;
 
 	Color c = Color::white().withAlpha(power / 60.0f * 200);
 
 	int offset = age % 40 / 10;
-	emitSpriteQuad(writer, x + player->getAngle() * 40, y + collider.y + level.getScroll(), 64, 32, player->getAngle(), tileset.sprite(4 + offset, 0), c.r, c.g, c.b, c.a);
+	emitSprite(layer, x + tilt * 40, y + collider.y + level.getScroll(), 64, 32, tilt, tileset.cell(4 + offset, 0), c.r, c.g, c.b, c.a);
 }
 
 void ShieldEntity::repower() {
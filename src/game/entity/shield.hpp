@@ -10,15 +10,20 @@ class ShieldEntity : public Entity {
 
 		bool damaged = false;
 		int power = 0;
-		std::shared_ptr<PlayerEntity> player;
+		EntityHandle player;
 
-		void updatePosition();
+		// angle of the player when last seen, the shield follows its tilt
+		float tilt = 0;
+
+		void updatePosition(PlayerEntity& player);
 
 	public:
 
-		ShieldEntity(const std::shared_ptr<PlayerEntity>& player);
+		ShieldEntity(PlayerEntity* player);
+
+		static void* operator new(size_t size);
+		static void operator delete(void* pointer, size_t size);
 
-		bool shouldCollide(Entity* entity) override;
 		void onDamage(Level& level, int damage, Entity* damager) override;
 		void tick(Level& level) override;
 
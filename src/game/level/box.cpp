@@ -13,6 +13,10 @@ Box Box::withOffset(float ox, float oy) const {
 	return {x + ox, y + oy, w, h};
 }
 
+Box Box::withMargin(float margin) const {
+	return {x - margin, y - margin, w + margin * 2, h + margin * 2};
+}
+
 bool Box::intersects(const Box& other) const {
 
 	const auto tb = begin();
@@ -27,3 +31,42 @@ bool Box::intersects(const Box& other) const {
 	return true;
 
 }
+
+bool Box::raycast(glm::vec2 from, glm::vec2 to, float& time) const {
+
+	const glm::vec2 delta = to - from;
+	const glm::vec2 tb = begin();
+	const glm::vec2 te = end();
+
+	float enter = 0;
+	float exit = 1;
+
+	// clip the segment against the slab of each axis in turn
+	for (int axis = 0; axis < 2; axis ++) {
+		if (delta[axis] == 0) {
+			if (from[axis] < tb[axis] || from[axis] > te[axis]) {
+				return false;
+			}
+
+			continue;
+		}
+
+		float near = (tb[axis] - from[axis]) / delta[axis];
+		float far = (te[axis] - from[axis]) / delta[axis];
+
+		if (near > far) {
+			std::swap(near, far);
+		}
+
+		enter = std::max(enter, near);
+		exit = std::min(exit, far);
+
+		if (enter > exit) {
+			return false;
+		}
+	}
+
+	time = enter;
+	return true;
+
+}
@@ -14,8 +14,14 @@ struct Box {
 
 	Box withOffset(float ox, float oy) const;
 
+	/// Grow the box by the margin on all sides
+	Box withMargin(float margin) const;
+
 	bool intersects(const Box& other) const;
 
+	/// Check if the segment hits the box, time is set to the fraction of the segment travelled before entering it
+	bool raycast(glm::vec2 from, glm::vec2 to, float& time) const;
+
 };
 
 
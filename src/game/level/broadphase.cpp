@@ -0,0 +1,100 @@
+
+#include "broadphase.hpp"
+
+/*
+ * SpatialHash
+ */
+
+SpatialHash::SpatialHash()
+: starts(buckets + 1, 0) {}
+
+SpatialHash::CellRange SpatialHash::getCellRange(const Box& box, float margin) {
+	const glm::ivec2 begin = glm::floor((box.begin() - margin) / (float) cell);
+	const glm::ivec2 end = glm::floor((box.end() + margin) / (float) cell);
+
+	return {begin.x, begin.y, end.x, end.y};
+}
+
+uint32_t SpatialHash::getBucket(int cx, int cy) {
+	return ((uint32_t) cx * 73856093u ^ (uint32_t) cy * 19349663u) & (buckets - 1);
+}
+
+void SpatialHash::rebuild(const std::vector<Entity*>& entities) {
+	items.clear();
+	layers.clear();
+	masks.clear();
+
+	for (Entity* entity : entities) {
+		if (entity->getCollisionLayer() != CollisionLayer::DECOR) {
+			items.push_back(entity);
+			layers.push_back(maskOf(entity->getCollisionLayer()));
+			masks.push_back(entity->getCollisionMask());
+		}
+	}
+
+	previous = current;
+	current = {};
+
+	// query numbers start over, so marks left by the previous contents must go too
+	marks.assign(items.size(), 0);
+	query = 0;
+
+	// count the items in each bucket first, so that they can be stored back to back
+	std::fill(starts.begin(), starts.end(), 0);
+
+	for (Entity* entity : items) {
+		const CellRange range = getCellRange(entity->getBoxCollider(), 0);
+
+		for (int cx = range.x0; cx <= range.x1; cx ++) {
+			for (int cy = range.y0; cy <= range.y1; cy ++) {
+				starts[getBucket(cx, cy) + 1] ++;
+			}
+		}
+	}
+
+	for (int bucket = 0; bucket < buckets; bucket ++) {
+		starts[bucket + 1] += starts[bucket];
+	}
+
+	cells.resize(starts[buckets]);
+	std::vector<uint32_t> heads {starts.begin(), starts.end() - 1};
+
+	for (uint32_t index = 0; index < items.size(); index ++) {
+		const CellRange range = getCellRange(items[index]->getBoxCollider(), 0);
+
+		for (int cx = range.x0; cx <= range.x1; cx ++) {
+			for (int cy = range.y0; cy <= range.y1; cy ++) {
+				cells[heads[getBucket(cx, cy)] ++] = index;
+			}
+		}
+	}
+}
+
+const std::vector<uint32_t>& SpatialHash::gather(const Box& box) const {
+	const CellRange range = getCellRange(box, slack);
+	candidates.clear();
+	query ++;
+
+	for (int cx = range.x0; cx <= range.x1; cx ++) {
+		for (int cy = range.y0; cy <= range.y1; cy ++) {
+			const uint32_t bucket = getBucket(cx, cy);
+
+			for (uint32_t i = starts[bucket]; i < starts[bucket + 1]; i ++) {
+				const uint32_t index = cells[i];
+
+				if (marks[index] != query) {
+					marks[index] = query;
+					candidates.push_back(index);
+				}
+			}
+		}
+	}
+
+	// keep the order of a linear scan, so that the same entity is hit first
+	std::sort(candidates.begin(), candidates.end());
+	return candidates;
+}
+
+const BroadphaseStats& SpatialHash::getStats() const {
+	return previous;
+}
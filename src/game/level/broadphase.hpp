@@ -0,0 +1,127 @@
+#pragma once
+
+#include "external.hpp"
+#include "box.hpp"
+#include "game/entity/entity.hpp"
+
+/// Number of collision candidates tested during a single tick
+struct BroadphaseStats {
+
+	uint32_t tested = 0; // candidate pairs passed to the exact test
+	uint32_t hits = 0;   // candidate pairs that actually collided
+
+};
+
+/**
+ * Spatial hash over entity colliders, rebuilt once per tick after entities
+ * were added and removed, so collision queries only visit entities in nearby cells.
+ * Entities keep moving after the rebuild, queries account for that by looking
+ * a bit further than asked, the exact test always uses the current collider.
+ */
+class SpatialHash {
+
+	public:
+
+		/// Size of a single cell in pixels, four terrain tiles
+		static constexpr int cell = 32;
+
+		/// Number of buckets cells are hashed into, must be a power of two
+		static constexpr int buckets = 1024;
+
+		/// Furthest an entity can move within a tick after the rebuild
+		static constexpr float slack = 16;
+
+	private:
+
+		// entities in the order they were given, candidates are visited in this order
+		std::vector<Entity*> items;
+
+		// collision layers of the items, kept alongside so that pairs can be rejected without touching the entity
+		std::vector<CollisionMask> layers;
+		std::vector<CollisionMask> masks;
+
+		// bucket contents stored back to back, bucket b spans [starts[b], starts[b + 1])
+		std::vector<uint32_t> starts;
+		std::vector<uint32_t> cells;
+
+		// scratch space of queries, marks hold the number of the last query that visited an item
+		mutable std::vector<uint32_t> marks;
+		mutable std::vector<uint32_t> candidates;
+		mutable uint32_t query = 0;
+
+		mutable BroadphaseStats current;
+		BroadphaseStats previous;
+
+		// range of cells covered by a box, inclusive on both ends
+		struct CellRange {
+			int x0, y0;
+			int x1, y1;
+		};
+
+		static CellRange getCellRange(const Box& box, float margin);
+		static uint32_t getBucket(int cx, int cy);
+
+		/// Collect indices of items in cells near the box, sorted and without duplicates
+		const std::vector<uint32_t>& gather(const Box& box) const;
+
+	public:
+
+		SpatialHash();
+
+		/// Replace the contents of the hash, should be called after entities were added and removed, decor is left out
+		void rebuild(const std::vector<Entity*>& entities);
+
+		/// Find the first entity near the collider of self, in the order given to rebuild(), that can collide with self and satisfies the predicate
+		template <typename P>
+		NULLABLE Entity* find(const Entity* self, P predicate) const {
+			const CollisionMask layer = maskOf(self->getCollisionLayer());
+			const CollisionMask mask = self->getCollisionMask();
+
+			if (mask == 0) {
+				return nullptr;
+			}
+
+			for (uint32_t index : gather(self->getBoxCollider())) {
+				Entity* entity = items[index];
+
+				if (entity == self || !(mask & layers[index]) || !(layer & masks[index])) {
+					continue;
+				}
+
+				current.tested ++;
+
+				if (predicate(entity)) {
+					current.hits ++;
+					return entity;
+				}
+			}
+
+			return nullptr;
+		}
+
+		/// Invoke the callback for every entity near the box that can collide with the given layer and mask, the callback returns true on a hit
+		template <typename F>
+		void forEach(const Box& box, CollisionLayer layer, CollisionMask mask, F callback) const {
+			const CollisionMask bit = maskOf(layer);
+
+			if (mask == 0) {
+				return;
+			}
+
+			for (uint32_t index : gather(box)) {
+				if (!(mask & layers[index]) || !(bit & masks[index])) {
+					continue;
+				}
+
+				current.tested ++;
+
+				if (callback(items[index])) {
+					current.hits ++;
+				}
+			}
+		}
+
+		/// Get the stats of the tick that finished with the last rebuild
+		const BroadphaseStats& getStats() const;
+
+};
@@ -0,0 +1,296 @@
+
+#include "bullets.hpp"
+
+#include "level.hpp"
+#include "game/sounds.hpp"
+
+/*
+ * BulletSystem
+ */
+
+void BulletSystem::spawn(Entity* parent, float velocity, float x, float y, float angle, BulletConfig config) {
+	const glm::vec2 direction {cos(deg(270) - angle), sin(deg(270) - angle)};
+
+	uint8_t flags = 0;
+	if (parent->isCausedByPlayer()) flags |= PLAYER;
+	if (config.charged) flags |= CHARGED;
+	if (config.piercing) flags |= PIERCING;
+
+	this->x.push_back(x);
+	this->y.push_back(y);
+	this->dx.push_back(velocity * direction.x);
+	this->dy.push_back(velocity * direction.y);
+	this->angle.push_back(angle);
+	this->time.push_back(60 * 6);
+	this->cooldown.push_back(0);
+	this->flags.push_back(flags);
+
+	// the shooter can be removed while the bullet still flies, so remember who it was fired by
+	this->parents.push_back(parent->self());
+}
+
+void BulletSystem::remove(size_t index) {
+	const size_t last = flags.size() - 1;
+
+	x[index] = x[last];
+	y[index] = y[last];
+	dx[index] = dx[last];
+	dy[index] = dy[last];
+	angle[index] = angle[last];
+	time[index] = time[last];
+	cooldown[index] = cooldown[last];
+	flags[index] = flags[last];
+	parents[index] = parents[last];
+
+	x.pop_back();
+	y.pop_back();
+	dx.pop_back();
+	dy.pop_back();
+	angle.pop_back();
+	time.pop_back();
+	cooldown.pop_back();
+	flags.pop_back();
+	parents.pop_back();
+}
+
+void BulletSystem::integrate() {
+	const size_t count = flags.size();
+	moved = count;
+
+	// kept trivial so that the compiler can vectorize it
+	for (size_t i = 0; i < count; i ++) {
+		x[i] += dx[i];
+		y[i] += dy[i];
+	}
+}
+
+int BulletSystem::sweepBullets(glm::vec2 from, glm::vec2 to, float& earliest) const {
+	int hit = -1;
+
+	for (size_t i = 0; i < flags.size(); i ++) {
+		if (flags[i] & (PLAYER | DEAD)) {
+			continue;
+		}
+
+		// bullets fired during this tick haven't moved yet, they only start in the next one
+		const glm::vec2 other {x[i], y[i]};
+		const glm::vec2 motion = i < moved ? glm::vec2 {dx[i], dy[i]} : glm::vec2 {0, 0};
+
+		// both bullets move during the tick, so sweep ours relative to the other one, the time
+		// of entry is the same in both frames; both colliders are the same size, so the other
+		// bullet grows by our radius and we become a point
+		const Box box {-radius * 2, -radius * 2, radius * 4, radius * 4};
+		float entry;
+
+		if (box.raycast(from - (other - motion), to - other, entry) && entry < earliest) {
+			earliest = entry;
+			hit = i;
+		}
+	}
+
+	return hit;
+}
+
+bool BulletSystem::isTileProtected(const Level& level, glm::ivec2 pos, int tx, int ty) {
+	glm::ivec2 end {tx, ty};
+
+	for (glm::ivec2 point : trace(pos, end)) {
+		if (level.getTile(point.x, point.y) == 2) {
+			if (point == pos || point == end) {
+				continue;
+			}
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void BulletSystem::explode(Level& level, size_t index, glm::ivec2 pos) {
+	const int blast = (flags[index] & PLAYER) ? 5 : 4;
+
+	std::vector<glm::ivec2> broken;
+
+	for (int ox = -blast; ox <= blast; ox ++) {
+		for (int oy = -blast; oy <= blast; oy ++) {
+			if (sqrt(ox * ox + oy * oy) < blast) {
+
+				int tx = pos.x + ox;
+				int ty = pos.y + oy;
+
+				uint8_t tile = level.getTile(tx, ty);
+
+				if (tile != 0) {
+					if (!isTileProtected(level, pos, tx, ty)) {
+						broken.emplace_back(tx, ty);
+					}
+				}
+			}
+		}
+	}
+
+	for (glm::ivec2 pos : broken) {
+		glm::ivec2 vec = level.toEntityPos(pos.x, pos.y);
+		uint8_t tile = level.getTile(pos.x, pos.y);
+
+		level.setTile(pos.x, pos.y, 0);
+		level.getParticles().tile(x[index], y[index], tile, vec.x, vec.y);
+	}
+}
+
+void BulletSystem::collide(Level& level, size_t index) {
+
+	const glm::vec2 to {x[index], y[index]};
+	const glm::vec2 from = to - glm::vec2 {dx[index], dy[index]};
+	const bool player = flags[index] & PLAYER;
+
+	if (time[index] <= 0) {
+		flags[index] |= DEAD;
+	} else {
+		time[index] --;
+	}
+
+	if (flags[index] & CHARGED) {
+		level.getParticles().dust(to.x, to.y, 0, 0, 1, 1, 1, 30, Color::white().withAlpha(100));
+	}
+
+	// once we hit an entity with piercing we wait for some time
+	// before we can do that again (to not one-shot aliens)
+	// but we still need to collide with terrain
+	if (cooldown[index] > 0) {
+		cooldown[index] --;
+	}
+
+	// bullets of the same side pass through each other, so bursts fired from a single point
+	// (like the one of an exploding mine) don't shoot themselves down before they spread out
+	const CollisionLayer layer = player ? CollisionLayer::PLAYER_BULLET : CollisionLayer::ENEMY_BULLET;
+	const CollisionMask mask = player
+		? maskOf(CollisionLayer::ENEMY, CollisionLayer::ENEMY_BULLET, CollisionLayer::PICKUP)
+		: maskOf(CollisionLayer::PLAYER, CollisionLayer::PLAYER_BULLET, CollisionLayer::ENEMY);
+
+	const SweepHit terrain = level.sweepTiles(from, to);
+	SweepHit target = level.sweepEntities(from, to, radius, layer, mask);
+
+	// pairs of bullets are only checked from the side of the player, there are far fewer of those
+	int other = -1;
+
+	if (player) {
+		float earliest = target.collision.type == Collision::MISS ? 1 : target.time;
+		other = sweepBullets(from, to, earliest);
+
+		if (other != -1) {
+			target = {{}, earliest};
+		}
+	}
+
+	const bool hit = (target.collision.type != Collision::MISS) || (other != -1);
+	bool collided = false;
+	bool stopped = false;
+	glm::vec2 point = to;
+
+	if (hit && cooldown[index] == 0 && (terrain.collision.type == Collision::MISS || target.time <= terrain.time)) {
+		BulletConfig config {.charged = (flags[index] & CHARGED) != 0, .piercing = (flags[index] & PIERCING) != 0};
+
+		if (other != -1) {
+			flags[other] |= DEAD;
+		} else {
+			target.collision.entity->onHit(level, {level.getEntity(parents[index]), player, config});
+		}
+
+		if (config.piercing) {
+			cooldown[index] = 15;
+		} else {
+			flags[index] |= DEAD;
+			point = glm::mix(from, to, target.time);
+			stopped = true;
+		}
+
+		collided = true;
+	}
+
+	if (terrain.collision.type == Collision::TILE && !stopped) {
+		point = glm::mix(from, to, terrain.time);
+		x[index] = point.x;
+		y[index] = point.y;
+
+		explode(level, index, {terrain.collision.x, terrain.collision.y});
+
+		flags[index] |= DEAD;
+		collided = true;
+	}
+
+	if (collided) {
+		level.getParticles().blow(point.x, point.y);
+		SoundSystem::getInstance().add(Sounds::damage).play();
+	}
+
+	// bullets that fell below the screen are never coming back
+	if (y[index] + level.getScroll() < -radius * 2) {
+		flags[index] |= DEAD;
+	}
+}
+
+void BulletSystem::tick(Level& level) {
+	integrate();
+
+	// hits can fire new bullets, those only start moving in the next tick
+	const size_t count = flags.size();
+
+	for (size_t i = 0; i < count; i ++) {
+
+		// shot down by a bullet of the other side earlier in this tick
+		if (flags[i] & DEAD) {
+			continue;
+		}
+
+		collide(level, i);
+	}
+
+	for (size_t i = 0; i < flags.size();) {
+		if (flags[i] & DEAD) {
+			remove(i);
+			continue;
+		}
+
+		i ++;
+	}
+}
+
+void BulletSystem::draw(Level& level, Renderer& renderer) {
+	const TileSet& tiles = *renderer.terrain.tileset;
+	const float scroll = level.getScroll();
+
+	batch.clear();
+
+	for (size_t i = 0; i < flags.size(); i ++) {
+		const bool charged = flags[i] & CHARGED;
+		const Color color = (flags[i] & PLAYER) ? Color::blue(charged) : Color::red(charged);
+		const float alpha = std::min(time[i] / 10.0f, 1.0f);
+		const uint32_t sprite = tiles.cell((flags[i] & PIERCING) ? 7 : 6, 5);
+
+		batch.emplace_back(x[i], y[i] + scroll, 16, 16, angle[i], sprite, color.r, color.g, color.b, alpha * 255);
+	}
+
+	renderer.terrain.sprites(batch);
+}
+
+bool BulletSystem::overlaps(const Box& box, bool player) const {
+	const Box grown = box.withMargin(radius);
+
+	for (size_t i = 0; i < flags.size(); i ++) {
+		if ((flags[i] & DEAD) || ((flags[i] & PLAYER) != 0) != player) {
+			continue;
+		}
+
+		if (x[i] >= grown.x && x[i] <= grown.x + grown.w && y[i] >= grown.y && y[i] <= grown.y + grown.h) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+size_t BulletSystem::size() const {
+	return flags.size();
+}
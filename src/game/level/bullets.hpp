@@ -0,0 +1,105 @@
+#pragma once
+
+#include "external.hpp"
+#include "box.hpp"
+#include "game/entity/handle.hpp"
+#include "render/renderer.hpp"
+
+class Level;
+class Entity;
+
+struct BulletConfig {
+	bool charged = false;
+	bool piercing = false;
+};
+
+/// Bullet that hit an entity, the side is stored with the bullet so it's known even once the shooter is gone
+struct BulletHit {
+	NULLABLE Entity* shooter; // null if the shooter was already removed
+	bool player;              // fired from the side of the player
+	BulletConfig config;
+};
+
+/**
+ * All bullets in flight, kept out of the entity list as there can be hundreds of them
+ * after a mine goes off. Motion is stored as a structure of arrays and advanced for all
+ * bullets at once, then each bullet sweeps the segment it travelled against terrain,
+ * entities and bullets of the other side, so that fast bullets can't tunnel through anything.
+ */
+class BulletSystem {
+
+	public:
+
+		/// Half the size of a bullet collider, in pixels
+		static constexpr float radius = 4;
+
+	private:
+
+		enum Flags : uint8_t {
+			PLAYER   = 1 << 0, // fired by the player
+			CHARGED  = 1 << 1,
+			PIERCING = 1 << 2,
+			DEAD     = 1 << 3, // removed at the end of the tick
+		};
+
+		std::vector<float> x, y;
+		std::vector<float> dx, dy; // motion over a single tick
+		std::vector<float> angle;
+		std::vector<int16_t> time;
+		std::vector<int16_t> cooldown;
+		std::vector<uint8_t> flags;
+		std::vector<EntityHandle> parents;
+
+		// number of bullets advanced by the last integrate(), the ones after were fired during this tick
+		size_t moved = 0;
+
+		// reused between frames, so that drawing does not allocate
+		std::vector<SpriteInstance> batch;
+
+		void remove(size_t index);
+
+		/// Advance all bullets by a single tick
+		void integrate();
+
+		/// Find the earliest bullet of the other side hit while moving along the segment, accounting for the motion of the other bullets, or -1, only used by player bullets
+		int sweepBullets(glm::vec2 from, glm::vec2 to, float& earliest) const;
+
+		/// Resolve the motion of a single bullet over the last tick
+		void collide(Level& level, size_t index);
+
+		/// Break the terrain around the tile the bullet hit
+		void explode(Level& level, size_t index, glm::ivec2 pos);
+
+		/// Check if there is an indestructible tile between the point of impact and the given tile
+		static bool isTileProtected(const Level& level, glm::ivec2 pos, int tx, int ty);
+
+	public:
+
+		BulletSystem() = default;
+
+		/// Fire a bullet, its side is taken from the parent, which is remembered as the shooter
+		void spawn(Entity* parent, float velocity, float x, float y, float angle, BulletConfig config = {});
+
+		/// Move all bullets, apply their hits and remove the spent ones
+		void tick(Level& level);
+
+		/// Draw all bullets in a single batch
+		void draw(Level& level, Renderer& renderer);
+
+		/// Invoke the callback with the position of every live bullet of the given side
+		template <typename F>
+		void forEach(bool player, F callback) const {
+			for (size_t i = 0; i < flags.size(); i ++) {
+				if (!(flags[i] & DEAD) && ((flags[i] & PLAYER) != 0) == player) {
+					callback(glm::vec2 {x[i], y[i]});
+				}
+			}
+		}
+
+		/// Check if any live bullet of the given side overlaps the box
+		bool overlaps(const Box& box, bool player) const;
+
+		/// Get the number of bullets in flight
+		size_t size() const;
+
+};
@@ -19,9 +19,69 @@ glm::vec2 Level::toEntityPos(int x, int y) {
 }
 
 Level::Level(BiomeManager& manager)
-: manager(manager) {
+: manager(manager),
+score_text(SW - 16, SH - 32, 24, 20, Color::of(255, 255, 0, 220), TextMode::RIGHT),
+over_text(getOverStart(), SH / 2 + 24, 48 + 8, 48, Color::of(255, 255, 0, 220), TextMode::LEFT),
+over_score_text(getOverStart() - 8, SH / 2 + 16 - 48, 24, 20, Color::of(255, 255, 0, 220), TextMode::LEFT),
+over_hi_text(getOverStart() - 8, SH / 2 + 16 - 48 - 32, 24, 20, Color::of(255, 255, 0, 220), TextMode::LEFT) {
 	loadHighScore();
 	manager.tick(0);
+
+	over_text.set("GAME OVER");
+	over_hi_text.set("NEW HI-SCORE!");
+
+	for (int i = 0; i < 14; i ++) {
+		debug_text.emplace_back(16, SH - 64 - i * 32, 20, 16, Color::of(255, 255, 0, 220), TextMode::LEFT);
+	}
+
+	buildCredits();
+}
+
+Level::~Level() {
+	for (Entity* entity : entities) {
+		delete entity;
+	}
+
+	for (Entity* entity : pending) {
+		delete entity;
+	}
+}
+
+int Level::getOverStart() {
+	int spacing = 8;
+	int width = 48 + spacing;
+
+	return (SW - (strlen("GAME OVER") - 1) * width) / 2;
+}
+
+void Level::buildCredits() {
+	int half = SW/2;
+	int row = SH/2 - SH/6;
+
+	auto add = [&] (float x, float y, float spacing, float size, Color color, const char* text) {
+		credits_text.emplace_back(x, y, spacing, size, color, TextMode::CENTER).set(text);
+	};
+
+	add(SW / 2, SH - 64, 32, 24, Color::of(255, 255, 0, 255), "Credits");
+
+	// top left
+	add(half / 2, SH - 64*2, 24, 20, Color::of(255, 255, 0, 255), "Sounds Effects");
+	add(half / 2, SH - 64*2 - 32*2, 24, 20, Color::of(255, 255, 255, 255), "EVRetro");
+	add(half / 2, SH - 64*2 - 32*3, 24, 20, Color::of(255, 255, 255, 255), "Sophia Caldwell");
+	add(half / 2, SH - 64*2 - 32*4, 24, 20, Color::of(255, 255, 255, 255), "Cabled Mess");
+	add(half / 2, SH - 64*2 - 32*5, 24, 20, Color::of(255, 255, 255, 255), "magistermaks");
+
+	// top right
+	add(half / 2 + half, SH - 64*2, 24, 20, Color::of(255, 255, 0, 255), "Programming & Art");
+	add(half / 2 + half, SH - 64*2 - 32*2, 24, 20, Color::of(255, 255, 255, 255), "magistermaks");
+
+	// bottom left
+	add(half / 2, SH - 64*2 - row, 24, 20, Color::of(255, 255, 0, 255), "Shading");
+	add(half / 2, SH - 64*2 - row - 32*2, 24, 20, Color::of(255, 255, 255, 255), "Mattias");
+
+	// bottom right
+	add(half / 2 + half, SH - 64*2 - row, 24, 20, Color::of(255, 255, 0, 220), "Play Testing");
+	add(half / 2 + half, SH - 64*2 - row - 32*2, 24, 20, Color::of(255, 255, 255, 220), "Player400");
 }
 
 void Level::applyCustomSpawnLogic(Segment& segment) {
@@ -36,8 +96,7 @@ void Level::applyCustomSpawnLogic(Segment& segment) {
 	if ((selector == 0) || (selector == 1)) {
 		glm::ivec2 tile = segment.getRandomSpawnPos(0);
 		glm::vec2 pos = toEntityPos(tile.x, tile.y);
-		auto fighter = std::make_shared<FighterAlienEntity>(pos.x, pos.y, (int) manager.getEvolution());
-		trySpawn(fighter);
+		trySpawn(new FighterAlienEntity {pos.x, pos.y, (int) manager.getEvolution()});
 	}
 
 }
@@ -174,15 +233,19 @@ bool Level::trySpawnAlien(Segment& segment) {
 	return false;
 }
 
-std::shared_ptr<PlayerEntity> Level::getPlayer() {
-	return player;
+PlayerEntity* Level::getPlayer() {
+	return getEntity<PlayerEntity>(player);
+}
+
+Entity* Level::getEntity(EntityHandle handle) const {
+	return table.get(handle);
 }
 
 void Level::tick() {
 
-	// update player pointer
-	if (player && player->shouldRemove()) {
-		player.reset();
+	// update player handle
+	if (PlayerEntity* pointer = getPlayer(); pointer && pointer->shouldRemove()) {
+		player = {};
 	}
 
 	if (state == GameState::DEAD) {
@@ -242,28 +305,51 @@ void Level::tick() {
 		}
 	}
 
+	bullets.tick(*this);
+
 	for (auto& entity : entities) {
 		entity->tick(*this);
 	}
 
+	particles.tick(*this);
+
 	if (skip > 1) {
 		skip = 1;
 	}
 
-	entities.erase(std::remove_if(entities.begin(), entities.end(), [] (const auto& entity) {
+	const auto removed = [] (Entity* entity) {
 		return entity->shouldRemove();
-	}), entities.end());
+	};
+
+	// registries only refer to entities, the main list is what deletes them
+	for (auto& registry : kinds) {
+		std::erase_if(registry, removed);
+	}
+
+	std::erase_if(entities, [&] (Entity* entity) {
+		if (!entity->shouldRemove()) {
+			return false;
+		}
+
+		// the slot can now be reused, any remaining handles will resolve to null
+		table.remove(entity->self());
+		delete entity;
+		return true;
+	});
+
+	for (Entity* entity : pending) {
+		entities.push_back(entity);
+		kinds[(size_t) entity->getKind()].push_back(entity);
 
-	for (auto& entity : pending) {
-		entities.emplace_back(entity);
 		entity->onSpawned(*this, findSegment(toTilePos(entity->x, entity->y).y));
 
-		if (std::shared_ptr<PlayerEntity> shared_player = std::dynamic_pointer_cast<PlayerEntity>(entity)) {
-			player = shared_player;
+		if (entity->getKind() == EntityKind::PLAYER) {
+			player = entity->self();
 		}
 	}
 
 	pending.clear();
+	broadphase.rebuild(entities);
 
 	if (Input::matchKeys(Key::UP, Key::UP, Key::DOWN, Key::DOWN, Key::LEFT, Key::RIGHT, Key::LEFT, Key::RIGHT, Key::B, Key::A)) {
 		Input::purge();
@@ -278,29 +364,9 @@ void Level::tick() {
 }
 
 void Level::drawCredits(Renderer& renderer) {
-	int half = SW/2;
-	int row = SH/2 - SH/6;
-
-	emitTextQuads(renderer.text, SW / 2, SH - 64, 32, 24, 255, 255, 0, 255, "Credits", TextMode::CENTER);
-
-	// top left
-	emitTextQuads(renderer.text, half / 2, SH - 64*2, 24, 20, 255, 255, 0, 255, "Sounds Effects", TextMode::CENTER);
-	emitTextQuads(renderer.text, half / 2, SH - 64*2 - 32*2, 24, 20, 255, 255, 255, 255, "EVRetro", TextMode::CENTER);
-	emitTextQuads(renderer.text, half / 2, SH - 64*2 - 32*3, 24, 20, 255, 255, 255, 255, "Sophia Caldwell", TextMode::CENTER);
-	emitTextQuads(renderer.text, half / 2, SH - 64*2 - 32*4, 24, 20, 255, 255, 255, 255, "Cabled Mess", TextMode::CENTER);
-	emitTextQuads(renderer.text, half / 2, SH - 64*2 - 32*5, 24, 20, 255, 255, 255, 255, "magistermaks", TextMode::CENTER);
-
-	// top right
-	emitTextQuads(renderer.text, half / 2 + half, SH - 64*2, 24, 20, 255, 255, 0, 255, "Programming & Art", TextMode::CENTER);
-	emitTextQuads(renderer.text, half / 2 + half, SH - 64*2 - 32*2, 24, 20, 255, 255, 255, 255, "magistermaks", TextMode::CENTER);
-
-	// bottom left
-	emitTextQuads(renderer.text, half / 2, SH - 64*2 - row, 24, 20, 255, 255, 0, 255, "Shading", TextMode::CENTER);
-	emitTextQuads(renderer.text, half / 2, SH - 64*2 - row - 32*2, 24, 20, 255, 255, 255, 255, "Mattias", TextMode::CENTER);
-
-	// bottom right
-	emitTextQuads(renderer.text, half / 2 + half, SH - 64*2 - row, 24, 20, 255, 255, 0, 220, "Play Testing", TextMode::CENTER);
-	emitTextQuads(renderer.text,  half / 2 + half, SH - 64*2 - row - 32*2, 24, 20, 255, 255, 255, 220, "Player400", TextMode::CENTER);
+	for (TextMesh& mesh : credits_text) {
+		mesh.emit(renderer.text);
+	}
 }
 
 
@@ -314,19 +380,47 @@ void Level::draw(Renderer& renderer) {
 		entity->draw(*this, renderer);
 	}
 
+	bullets.draw(*this, renderer);
+	particles.draw(*this, renderer);
+
 	if (debug) {
 		for (auto& entity : entities) {
 			entity->debugDraw(*this, renderer);
 		}
 
-		emitTextQuads(renderer.text, 16, SH - 64,  20, 16, 255, 255, 0, 220, "Seg: " + std::to_string(total), TextMode::LEFT);
-		emitTextQuads(renderer.text, 16, SH - 96,  20, 16, 255, 255, 0, 220, "Bio: " + std::to_string(manager.getBiomeIndex()), TextMode::LEFT);
-		emitTextQuads(renderer.text, 16, SH - 128, 20, 16, 255, 255, 0, 220, "Spd: " + std::to_string(getSpeed()), TextMode::LEFT);
-		emitTextQuads(renderer.text, 16, SH - 160, 20, 16, 255, 255, 0, 220, "Ens: " + std::to_string(entities.size()), TextMode::LEFT);
+		debug_text[0].print("Seg: %d", total);
+		debug_text[1].print("Bio: %d", manager.getBiomeIndex());
+		debug_text[2].print("Spd: %f", getSpeed());
+		debug_text[3].print("Ens: %d + %d", (int) entities.size(), (int) bullets.size());
+
+		const FrameStats& stats = RenderStats::getInstance().last();
+		debug_text[4].print("Upl: %dK", (int) (stats.uploaded / 1024));
+		debug_text[5].print("Grw: %d", (int) stats.grows);
+		debug_text[6].print("Skp: %d", (int) stats.skipped);
+		debug_text[7].print("Bat: %d", (int) stats.batches);
+		debug_text[8].print("Drw: %d", (int) stats.draws);
+		debug_text[9].print("Res: %d%%", (int) std::round(stats.scale * 100));
+
+		if (stats.timed) {
+			debug_text[10].print("Gpu: %.2f + %.2fms", stats.scene_ms, stats.effect_ms);
+		} else {
+			debug_text[10].print("Gpu: n/a");
+		}
+
+		debug_text[11].print("Mem: %.1fM", stats.getTotalMemory() / (1024.0f * 1024.0f));
+		debug_text[12].print("Prt: %d", (int) particles.size());
+
+		const BroadphaseStats& collisions = broadphase.getStats();
+		debug_text[13].print("Col: %d/%d", (int) collisions.hits, (int) collisions.tested);
+
+		for (TextMesh& mesh : debug_text) {
+			mesh.emit(renderer.text);
+		}
 	}
 
 	if (state != GameState::DEAD) {
-		emitTextQuads(renderer.text, SW - 16, SH - 32, 24, 20, 255, 255, 0, 220, std::to_string(score), TextMode::RIGHT);
+		score_text.print("%d", score);
+		score_text.emit(renderer.text);
 	}
 
 	if (state == GameState::DEAD && (age % 120 < 60)) {
@@ -334,17 +428,12 @@ void Level::draw(Renderer& renderer) {
 			SoundSystem::getInstance().add(Sounds::beep).play();
 		}
 
-		std::string over = "GAME OVER";
-
-		int spacing = 8;
-		int width = 48 + spacing;
-		int start = (SW - (over.length() - 1) * width) / 2;
-
-		emitTextQuads(renderer.text, start, SH / 2 + 24, width, 48, 255, 255, 0, 220, over, TextMode::LEFT);
-		emitTextQuads(renderer.text, start - 8, SH / 2 + 16 - 48, 24, 20, 255, 255, 0, 220, "SCORE: " + std::to_string(score), TextMode::LEFT);
+		over_text.emit(renderer.text);
+		over_score_text.print("SCORE: %d", score);
+		over_score_text.emit(renderer.text);
 
 		if ((score > hi) && (age % 10 < 5)) {
-			emitTextQuads(renderer.text, start - 8, SH / 2 + 16 - 48 - 32, 24, 20, 255, 255, 0, 220, "NEW HI-SCORE!", TextMode::LEFT);
+			over_hi_text.emit(renderer.text);
 		}
 	}
 
@@ -452,26 +541,18 @@ Collision Level::checkTileCollision(const Box& box) const {
 
 Collision Level::checkEntityCollision(Entity* self) const {
 
-	// handle alredy existing entities
-	for (const auto& entity : entities) {
-		Entity* pointer = entity.get();
+	// handle alredy existing entities, entity collisions are handled by entities
+	Entity* hit = broadphase.find(self, [&] (Entity* pointer) {
+		return pointer->shouldCollide(self);
+	});
 
-		// skip invalid collisions
-		if (pointer == self || pointer == nullptr) {
-			continue;
-		}
-
-		// entity collisions are handled by entities
-		if (pointer->shouldCollide(self)) {
-			return {pointer};
-		}
+	if (hit) {
+		return {hit};
 	}
 
 	// handle entities added in this frame
-	for (const auto& entity : pending) {
-		Entity* pointer = entity.get();
-
-		if (pointer == self || pointer == nullptr) {
+	for (Entity* pointer : pending) {
+		if (pointer == self || pointer == nullptr || !pointer->canCollide(*self)) {
 			continue;
 		}
 
@@ -499,6 +580,101 @@ Collision Level::checkCollision(Entity* self) const {
 
 }
 
-std::vector<std::shared_ptr<Entity>>& Level::getEntities() {
+SweepHit Level::sweepTiles(glm::vec2 from, glm::vec2 to) const {
+
+	const float pixels = SW / Segment::width;
+	const glm::vec2 delta = to - from;
+
+	glm::ivec2 tile = floor(from / pixels);
+	const glm::ivec2 last = floor(to / pixels);
+
+	// fraction of the motion needed to cross a whole tile, and to reach the next tile boundary, for each axis
+	glm::vec2 across {std::numeric_limits<float>::infinity()};
+	glm::vec2 next {std::numeric_limits<float>::infinity()};
+	glm::ivec2 step {0, 0};
+
+	for (int axis = 0; axis < 2; axis ++) {
+		if (delta[axis] != 0) {
+			step[axis] = delta[axis] > 0 ? 1 : -1;
+			across[axis] = pixels / std::abs(delta[axis]);
+			next[axis] = ((tile[axis] + (step[axis] > 0 ? 1 : 0)) * pixels - from[axis]) / delta[axis];
+		}
+	}
+
+	float time = 0;
+
+	while (time <= 1) {
+		if (getTile(tile.x, tile.y)) {
+			return {{tile.x, tile.y}, time};
+		}
+
+		if (tile == last) {
+			break;
+		}
+
+		// step into whichever neighbour the segment reaches first
+		if (next.x < next.y) {
+			time = next.x;
+			tile.x += step.x;
+			next.x += across.x;
+		} else {
+			time = next.y;
+			tile.y += step.y;
+			next.y += across.y;
+		}
+	}
+
+	// no collision found
+	return {};
+
+}
+
+SweepHit Level::sweepEntities(glm::vec2 from, glm::vec2 to, float radius, CollisionLayer layer, CollisionMask mask) const {
+
+	const glm::vec2 begin = glm::min(from, to) - radius;
+	const glm::vec2 end = glm::max(from, to) + radius;
+	SweepHit hit;
+
+	// growing the collider by the radius turns the moving box into a moving point
+	const auto test = [&] (Entity* entity) {
+		float time;
+
+		if (entity->isIntangible() || !entity->getBoxCollider().withMargin(radius).raycast(from, to, time)) {
+			return false;
+		}
+
+		if (hit.collision.type == Collision::MISS || time < hit.time) {
+			hit = {{entity}, time};
+		}
+
+		return true;
+	};
+
+	broadphase.forEach(Box {begin.x, begin.y, end.x - begin.x, end.y - begin.y}, layer, mask, test);
+
+	// handle entities added in this frame
+	for (Entity* pointer : pending) {
+		if ((pointer->getCollisionMask() & maskOf(layer)) && (mask & maskOf(pointer->getCollisionLayer()))) {
+			test(pointer);
+		}
+	}
+
+	return hit;
+
+}
+
+ParticleSystem& Level::getParticles() {
+	return particles;
+}
+
+BulletSystem& Level::getBullets() {
+	return bullets;
+}
+
+const std::vector<Entity*>& Level::getEntities() const {
 	return entities;
+}
+
+const std::vector<Entity*>& Level::getEntities(EntityKind kind) const {
+	return kinds[(size_t) kind];
 }
\ No newline at end of file
@@ -7,7 +7,11 @@
 #include "game/entity/player.hpp"
 #include "biome.hpp"
 #include "box.hpp"
+#include "broadphase.hpp"
+#include "particles.hpp"
+#include "bullets.hpp"
 #include "render/renderer.hpp"
+#include "game/emitter.hpp"
 
 enum struct GameState {
 	BEGIN,
@@ -38,6 +42,14 @@ struct Collision {
 
 };
 
+/// Result of a swept query, time is the fraction of the motion travelled before the hit
+struct SweepHit {
+
+	Collision collision;
+	float time = 1;
+
+};
+
 class Level {
 
 	public:
@@ -73,17 +85,47 @@ class Level {
 
 		std::array<Segment, 4> segments;
 
-		std::vector<std::shared_ptr<Entity>> pending {};
-		std::vector<std::shared_ptr<Entity>> entities {};
-		std::shared_ptr<PlayerEntity> player {};
+		// retained text, glyphs are only regenerated when it changes
+		TextMesh score_text;
+		TextMesh over_text;
+		TextMesh over_score_text;
+		TextMesh over_hi_text;
+		std::vector<TextMesh> debug_text;
+		std::vector<TextMesh> credits_text;
+
+		// entities are owned by the level, everything else refers to them through handles
+		EntityTable table;
+		std::vector<Entity*> pending {};
+		std::vector<Entity*> entities {};
+		EntityHandle player {};
+
+		// subsets of entities, updated together with the entity list
+		std::array<std::vector<Entity*>, (size_t) EntityKind::COUNT> kinds;
+
+		// entities added in this tick are not in the broadphase yet, queries check them separately
+		SpatialHash broadphase;
+
+		// short lived effects and bullets, kept apart from entities
+		ParticleSystem particles;
+		BulletSystem bullets;
 
 		void applyCustomSpawnLogic(Segment& segment);
 
+		/// Get the horizontal position of the "GAME OVER" text
+		static int getOverStart();
+
+		void buildCredits();
+
 	public:
 
 		void beginPlay();
 
 		Level(BiomeManager& manager);
+		~Level();
+
+		Level(const Level&) = delete;
+		Level& operator=(const Level&) = delete;
+
 		void loadHighScore();
 		void spawnInitial();
 		void loadPlayCount();
@@ -95,30 +137,34 @@ class Level {
 		bool isDebug() const;
 
 		bool trySpawnAlien(Segment& segment);
-		std::shared_ptr<PlayerEntity> getPlayer();
+		NULLABLE PlayerEntity* getPlayer();
 
-		template<typename T>
-		std::shared_ptr<T> addEntity(T* entity) {
-			return std::static_pointer_cast<T>(pending.emplace_back(entity));
-		}
+		/// Get the entity the handle refers to, or null if it was already removed
+		NULLABLE Entity* getEntity(EntityHandle handle) const;
 
+		/// Get the entity the handle refers to, the handle must have been taken from an entity of type T
 		template<typename T>
-		void addEntity(const std::shared_ptr<T>& entity) {
-			pending.emplace_back(entity);
+		NULLABLE T* getEntity(EntityHandle handle) const {
+			return static_cast<T*>(getEntity(handle));
 		}
 
+		/// Take ownership of the entity, it will be added to the world at the end of this tick
 		template<typename T>
-		bool trySpawn(T* entity) {
-			return trySpawn(std::shared_ptr<T> {entity});
+		T* addEntity(T* entity) {
+			entity->handle = table.insert(entity);
+			pending.push_back(entity);
+			return entity;
 		}
 
+		/// Take ownership of the entity, it is added only if its placement is valid and destroyed otherwise
 		template<typename T>
-		bool trySpawn(const std::shared_ptr<T>& entity) {
+		bool trySpawn(T* entity) {
 			if (entity->checkPlacement(*this)) {
-				pending.emplace_back(entity);
+				addEntity(entity);
 				return true;
 			}
 
+			delete entity;
 			return false;
 		}
 
@@ -136,7 +182,18 @@ class Level {
 		Collision checkEntityCollision(Entity* self) const;
 		Collision checkCollision(Entity* self) const;
 
+		/// Find the first tile along the segment, walking the tile grid cell by cell
+		SweepHit sweepTiles(glm::vec2 from, glm::vec2 to) const;
+
+		/// Find the earliest entity hit by a box of the given radius moving along the segment
+		SweepHit sweepEntities(glm::vec2 from, glm::vec2 to, float radius, CollisionLayer layer, CollisionMask mask) const;
+
 		void setState(GameState state);
 
-		std::vector<std::shared_ptr<Entity>>& getEntities();
+		ParticleSystem& getParticles();
+		BulletSystem& getBullets();
+		const std::vector<Entity*>& getEntities() const;
+
+		/// Get all entities of the given kind, in the order they were added
+		const std::vector<Entity*>& getEntities(EntityKind kind) const;
 };
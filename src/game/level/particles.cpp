@@ -0,0 +1,216 @@
+
+#include "particles.hpp"
+
+#include "level.hpp"
+#include "tile.hpp"
+
+#if defined(__SSE__)
+	#include <xmmintrin.h>
+#elif defined(__wasm_simd128__)
+	#include <wasm_simd128.h>
+#endif
+
+/*
+ * ParticleSystem
+ */
+
+void ParticleSystem::spawn(float x, float y, float vx, float vy, float angle, float spin, float drag, const Look& look) {
+	this->x.push_back(x);
+	this->y.push_back(y);
+	this->vx.push_back(vx);
+	this->vy.push_back(vy);
+	this->angle.push_back(angle);
+	this->spin.push_back(spin);
+	this->drag.push_back(drag);
+	this->age.push_back(0);
+	this->looks.push_back(look);
+}
+
+void ParticleSystem::remove(size_t index) {
+	const size_t last = looks.size() - 1;
+
+	// order does not matter, so just move the last particle into the gap
+	x[index] = x[last];
+	y[index] = y[last];
+	vx[index] = vx[last];
+	vy[index] = vy[last];
+	angle[index] = angle[last];
+	spin[index] = spin[last];
+	drag[index] = drag[last];
+	age[index] = age[last];
+	looks[index] = looks[last];
+
+	x.pop_back();
+	y.pop_back();
+	vx.pop_back();
+	vy.pop_back();
+	angle.pop_back();
+	spin.pop_back();
+	drag.pop_back();
+	age.pop_back();
+	looks.pop_back();
+}
+
+void ParticleSystem::integrate() {
+	const size_t count = looks.size();
+	size_t i = 0;
+
+	#if defined(__SSE__)
+		const __m128 one = _mm_set1_ps(1.0f);
+
+		for (; i + 4 <= count; i += 4) {
+			const __m128 fx = _mm_loadu_ps(&vx[i]);
+			const __m128 fy = _mm_loadu_ps(&vy[i]);
+			const __m128 damping = _mm_loadu_ps(&drag[i]);
+
+			_mm_storeu_ps(&x[i], _mm_add_ps(_mm_loadu_ps(&x[i]), fx));
+			_mm_storeu_ps(&y[i], _mm_add_ps(_mm_loadu_ps(&y[i]), fy));
+			_mm_storeu_ps(&vx[i], _mm_mul_ps(fx, damping));
+			_mm_storeu_ps(&vy[i], _mm_mul_ps(fy, damping));
+			_mm_storeu_ps(&angle[i], _mm_add_ps(_mm_loadu_ps(&angle[i]), _mm_loadu_ps(&spin[i])));
+			_mm_storeu_ps(&age[i], _mm_add_ps(_mm_loadu_ps(&age[i]), one));
+		}
+	#elif defined(__wasm_simd128__)
+		const v128_t one = wasm_f32x4_splat(1.0f);
+
+		for (; i + 4 <= count; i += 4) {
+			const v128_t fx = wasm_v128_load(&vx[i]);
+			const v128_t fy = wasm_v128_load(&vy[i]);
+			const v128_t damping = wasm_v128_load(&drag[i]);
+
+			wasm_v128_store(&x[i], wasm_f32x4_add(wasm_v128_load(&x[i]), fx));
+			wasm_v128_store(&y[i], wasm_f32x4_add(wasm_v128_load(&y[i]), fy));
+			wasm_v128_store(&vx[i], wasm_f32x4_mul(fx, damping));
+			wasm_v128_store(&vy[i], wasm_f32x4_mul(fy, damping));
+			wasm_v128_store(&angle[i], wasm_f32x4_add(wasm_v128_load(&angle[i]), wasm_v128_load(&spin[i])));
+			wasm_v128_store(&age[i], wasm_f32x4_add(wasm_v128_load(&age[i]), one));
+		}
+	#endif
+
+	for (; i < count; i ++) {
+		x[i] += vx[i];
+		y[i] += vy[i];
+		vx[i] *= drag[i];
+		vy[i] *= drag[i];
+		angle[i] += spin[i];
+		age[i] += 1;
+	}
+}
+
+void ParticleSystem::dust(float x, float y, float fx, float fy, float angle, float rotation, float jitter, int lifetime, Color color) {
+	Look look {};
+	look.lifetime = lifetime;
+	look.size = 4;
+	look.grow = 5;
+	look.fade = 200.0f / lifetime;
+	look.color = color.withAlpha(255);
+	look.sheet = ParticleSheet::TILES;
+
+	fx += randomFloat(-1, 1) * jitter;
+	fy += randomFloat(-1, 1) * jitter;
+	spawn(x, y, fx, fy, angle, randomFloat(-1, 1) * rotation, 1, look);
+}
+
+void ParticleSystem::tile(float x, float y, uint8_t tile, int tx, int ty) {
+	const float dx = x - tx;
+	const float dy = y - ty;
+
+	Look look {};
+	look.lifetime = 10;
+	look.size = 4;
+	look.fade = 255.0f / look.lifetime;
+	look.color = Color::white();
+	look.sheet = ParticleSheet::TILES;
+	look.sx = tile;
+	look.sy = 4;
+
+	// gold is worth something even when it's shot out of the terrain
+	look.score = (tile == 3) ? 10 : 0;
+
+	spawn(tx, ty, std::clamp(1 / (1 + dx), -8.0f, 8.0f), std::clamp(1 / (1 + dy), -8.0f, 8.0f), 0, 0, 0.9f, look);
+}
+
+void ParticleSystem::blow(float x, float y) {
+	Look look {};
+	look.lifetime = 5 * 4 - 1;
+	look.size = 64;
+	look.color = Color::white();
+	look.sheet = ParticleSheet::TILES;
+	look.sy = 2;
+	look.frames = 5;
+
+	spawn(x, y, 0, 0, 0, 0, 1, look);
+}
+
+void ParticleSystem::text(float x, float y, std::string_view text, int lifetime) {
+	const float spacing = 16;
+	float offset = - (text.length() * spacing) / 2.0f;
+
+	// every glyph is a particle of its own, they all move the same way so they stay together
+	Look look {};
+	look.size = 12;
+	look.hold = lifetime;
+	look.fade = 8;
+	look.lifetime = lifetime + std::ceil(255 / look.fade) - 1;
+	look.color = Color::of(255, 255, 0);
+	look.sheet = ParticleSheet::FONT;
+
+	for (char glyph : text) {
+		look.sx = (uint8_t) glyph;
+		spawn(x + offset, y, 0, 1.8f, 0, 0, 1, look);
+		offset += spacing;
+	}
+}
+
+void ParticleSystem::tick(Level& level) {
+	integrate();
+
+	const float scroll = level.getScroll();
+
+	for (size_t i = 0; i < looks.size();) {
+		const Look& look = looks[i];
+
+		// particles that fell below the screen are never coming back
+		if (age[i] > look.lifetime || y[i] + scroll < -look.size) {
+			if (look.score) {
+				level.addScore(look.score);
+			}
+
+			remove(i);
+			continue;
+		}
+
+		i ++;
+	}
+}
+
+void ParticleSystem::draw(Level& level, Renderer& renderer) {
+	const TileSet& tiles = *renderer.terrain.tileset;
+	const TileSet& font = *renderer.text.tileset;
+	const float scroll = level.getScroll();
+
+	tiles_batch.clear();
+	font_batch.clear();
+
+	for (size_t i = 0; i < looks.size(); i ++) {
+		const Look& look = looks[i];
+
+		const float delta = age[i] / look.lifetime;
+		const float size = look.size + look.grow * delta;
+		const float alpha = std::clamp(look.color.a - look.fade * std::max(0.0f, age[i] - look.hold), 0.0f, 255.0f);
+		const int frame = look.frames ? (int) age[i] / look.frames : 0;
+
+		if (look.sheet == ParticleSheet::FONT) {
+			font_batch.emplace_back(x[i], y[i] + scroll, -size, size, angle[i], font.cell((int) look.sx), look.color.r, look.color.g, look.color.b, alpha);
+		} else {
+			tiles_batch.emplace_back(x[i], y[i] + scroll, size, size, angle[i], tiles.cell(look.sx + frame, look.sy), look.color.r, look.color.g, look.color.b, alpha);
+		}
+	}
+
+	renderer.terrain.sprites(tiles_batch);
+	renderer.text.sprites(font_batch);
+}
+
+size_t ParticleSystem::size() const {
+	return looks.size();
+}
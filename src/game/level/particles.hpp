@@ -0,0 +1,83 @@
+#pragma once
+
+#include "external.hpp"
+#include "game/color.hpp"
+#include "render/renderer.hpp"
+
+class Level;
+
+/// Sprite sheet a particle is drawn from
+enum struct ParticleSheet : uint8_t {
+	TILES = 0, // terrain tileset, drawn into the terrain layer
+	FONT  = 1, // font glyphs, drawn mirrored into the text layer
+};
+
+/**
+ * Short lived visual effects, kept out of the entity list so that they never take
+ * part in collision checks. Motion is stored as a structure of arrays and integrated
+ * four particles at a time, dead particles are swap-removed, so spawning is free
+ * of allocations once the arrays have grown to fit the busiest moment.
+ */
+class ParticleSystem {
+
+	private:
+
+		// everything that does not change after the particle is spawned
+		struct Look {
+			float lifetime;  // age at which the particle is removed
+			float size;      // size at spawn, in pixels
+			float grow;      // size added over the lifetime
+			float hold;      // ticks before the particle starts fading out
+			float fade;      // alpha lost every tick after the hold
+			Color color;
+			ParticleSheet sheet;
+			uint8_t sx, sy;  // tile within the sheet, for the font sx is the glyph
+			uint8_t frames;  // ticks per animation frame, frames advance along x, zero if static
+			int16_t score;   // points awarded once the particle expires
+		};
+
+		// motion, integrated every tick
+		std::vector<float> x, y;
+		std::vector<float> vx, vy;
+		std::vector<float> angle, spin;
+		std::vector<float> drag;
+		std::vector<float> age;
+
+		std::vector<Look> looks;
+
+		// reused between frames, so that drawing does not allocate either
+		std::vector<SpriteInstance> tiles_batch;
+		std::vector<SpriteInstance> font_batch;
+
+		void spawn(float x, float y, float vx, float vy, float angle, float spin, float drag, const Look& look);
+		void remove(size_t index);
+
+		/// Advance motion and age of all particles by a single tick
+		void integrate();
+
+	public:
+
+		ParticleSystem() = default;
+
+		/// Small spinning speck that drifts, grows and fades out
+		void dust(float x, float y, float fx, float fy, float angle, float rotation, float jitter, int lifetime, Color color);
+
+		/// Fragment of a destroyed tile, thrown away from the point of impact
+		void tile(float x, float y, uint8_t tile, int tx, int ty);
+
+		/// Explosion animation
+		void blow(float x, float y);
+
+		/// Centered text that floats upwards and fades out once its lifetime passes
+		void text(float x, float y, std::string_view text, int lifetime);
+
+		/// Update all particles and remove the expired ones
+		void tick(Level& level);
+
+		/// Draw all particles, each sheet in a single batch
+		void draw(Level& level, Renderer& renderer);
+
+		/// Get the number of live particles
+		size_t size() const;
+
+};
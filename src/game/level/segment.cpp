@@ -31,14 +31,14 @@ void Segment::drawTile(RenderLayer& layer, int tile, int x, int y, int width, fl
 	const float ex = tx + unit;
 	const float ey = ty + unit;
 
-	Sprite s = getTileSprite(*layer.tileset, tile);
-
-	layer.writer->push({tx, ty, s.min_u, s.min_v, r, g, b, a});
-	layer.writer->push({ex, ty, s.max_u, s.min_v, r, g, b, a});
-	layer.writer->push({ex, ey, s.max_u, s.max_v, r, g, b, a});
-	layer.writer->push({ex, ey, s.max_u, s.max_v, r, g, b, a});
-	layer.writer->push({tx, ey, s.min_u, s.max_v, r, g, b, a});
-	layer.writer->push({tx, ty, s.min_u, s.min_v, r, g, b, a});
+	const Sprite& s = getTileSprite(*layer.tileset, tile);
+
+	layer.quad(
+		{tx, ty, s.min_u, s.min_v, r, g, b, a},
+		{ex, ty, s.max_u, s.min_v, r, g, b, a},
+		{ex, ey, s.max_u, s.max_v, r, g, b, a},
+		{tx, ey, s.min_u, s.max_v, r, g, b, a}
+	);
 }
 
 void Segment::fill(int tile) {
@@ -1,6 +1,10 @@
 
 #include "tile.hpp"
 
-Sprite getTileSprite(TileSet& tileset, uint8_t tile) {
+const Sprite& getTileSprite(const TileSet& tileset, uint8_t tile) {
 	return tileset.sprite(tile, 4);
+}
+
+uint32_t getTileCell(const TileSet& tileset, uint8_t tile) {
+	return tileset.cell(tile, 4);
 }
\ No newline at end of file
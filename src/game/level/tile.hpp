@@ -3,4 +3,5 @@
 #include "external.hpp"
 #include "rendering.hpp"
 
-Sprite getTileSprite(TileSet& tileset, uint8_t tile);
\ No newline at end of file
+const Sprite& getTileSprite(const TileSet& tileset, uint8_t tile);
+uint32_t getTileCell(const TileSet& tileset, uint8_t tile);
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "game/sounds.hpp"
 #include "game/level/level.hpp"
 #include "render/renderer.hpp"
+#include "render/pipeline.hpp"
+#include "render/report.hpp"
 
 // docs
 // https://emscripten.org/docs/api_reference/html5.h.html
@@ -70,7 +72,7 @@ void checkViewport(float ratio, const std::function<void(int, int, int, int, glm
 
 int main() {
 
-	auto begin_time = std::chrono::steady_clock::now();
+	const double begin_time = platform_get_time();
 
 	Renderer renderer {};
 
@@ -83,42 +85,83 @@ int main() {
 	printf("All game systems ready!\n");
 	printf("You can press and hold the TAB key to see credits & attribution.\n");
 
-	int vw, vh;
+	#if defined(GAME_HEADLESS)
+		const char* report_path = getenv("HEADLESS_REPORT");
+		FrameReport report {report_path ? report_path : "report.csv"};
 
-	setMainLoop([&] {
+		// always render at full resolution, so that the output is comparable between runs
+		renderer.scaler.setBounds(1.0f, 1.0f);
+	#endif
 
-		game.tick();
+	#if defined(PLATFORM_RENDER_THREAD)
 
-		// takes care of the screen ratio, calls the callback when the screen resizes
-		checkViewport(ASPECT_RATIO, [&] (int w, int h, int rw, int rh, glm::mat4& matrix) {
-			glm::mat4 static_matrix {
-				 2.0f/SW, 0,       0,   0,
-				 0,       2.0f/SH, 0,   0,
-				 0,       0,       1,   0,
-				-1,      -1,       0,   1,
-			};
+		// at most two frames are in flight, so the game can run ahead only while the last frame is presented
+		DrawPipeline pipeline {getCanvasSize()};
 
-			renderer.level_shader.use();
-			glUniformMatrix4fv(renderer.level_shader.uniform("uMatrix"), 1, GL_FALSE, glm::value_ptr(static_matrix));
+		std::thread game_thread([&] {
+			while (DrawList* list = pipeline.acquire()) {
+				game.tick();
 
-			renderer.degrade_shader.use();
-			glUniform2f(renderer.degrade_shader.uniform("uResolution"), rw, rh);
-			glUniformMatrix4fv(renderer.degrade_shader.uniform("uMatrix"), 1, GL_FALSE, glm::value_ptr(matrix));
+				renderer.beginDraw(platform_get_time() - begin_time, game.level->getLinearAliveness(), list->canvas);
+				game.level->draw(renderer);
+				renderer.endDraw(*list);
 
-			vw = w;
-			vh = h;
+				pipeline.submit();
+				SoundSystem::getInstance().update();
+				Input::clear();
+			}
 		});
 
-		renderer.beginDraw(begin_time, game.level->getLinearAliveness());
+		setMainLoop([&] {
 
-		// render
-		game.level->draw(renderer);
+			// takes care of the screen ratio, calls the callback when the screen resizes
+			checkViewport(ASPECT_RATIO, [&] (int w, int h, int rw, int rh, glm::mat4& matrix) {
+				renderer.setViewport(w, h, rw, rh, matrix);
+			});
 
-		renderer.endDraw(vw, vh);
-		SoundSystem::getInstance().update();
-		Input::clear();
+			if (DrawList* list = pipeline.consume()) {
+				renderer.draw(*list);
+				pipeline.release();
+			}
 
-	});
+		});
+
+		// the loop returns once the window is closed, the game thread has to stop before anything is torn down
+		pipeline.close();
+		game_thread.join();
+
+	#else
+
+		setMainLoop([&] {
+
+			game.tick();
+
+			// takes care of the screen ratio, calls the callback when the screen resizes
+			checkViewport(ASPECT_RATIO, [&] (int w, int h, int rw, int rh, glm::mat4& matrix) {
+				renderer.setViewport(w, h, rw, rh, matrix);
+			});
+
+			renderer.beginDraw(platform_get_time() - begin_time, game.level->getLinearAliveness(), getCanvasSize());
+
+			// render
+			game.level->draw(renderer);
+
+			renderer.endDraw();
+
+			#if defined(GAME_HEADLESS)
+				report.record(RenderStats::getInstance().frame());
+			#endif
+
+			SoundSystem::getInstance().update();
+			Input::clear();
+
+		});
+
+	#endif
+
+	#if defined(GAME_HEADLESS)
+		report.summary();
+	#endif
 
 	printf("Main returned without error\n");
     return EXIT_SUCCESS;
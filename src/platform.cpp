@@ -7,4 +7,11 @@
 	int impl::screen_height;
 	PlatformKeyEventCallback impl::keydown_callback;
 	PlatformKeyEventCallback impl::keyup_callback;
+
+	#if defined(GAME_HEADLESS)
+		GLuint impl::main_framebuffer = 0;
+		int impl::frame = 0;
+	#else
+		bool impl::quit = false;
+	#endif
 #endif
@@ -43,6 +43,11 @@ using PlatformLoopCallback = void(*)();
 	#include <emscripten.h>
 	#include <emscripten/html5.h>
 	#include <GLES3/gl3.h>
+	#include <GLES2/gl2ext.h>
+
+	// from EXT_disjoint_timer_query_webgl2, the names match desktop GL
+	#define GL_TIME_ELAPSED GL_TIME_ELAPSED_EXT
+	#define GL_GPU_DISJOINT GL_GPU_DISJOINT_EXT
 
 	#define EXPORTED_NATIVE EMSCRIPTEN_KEEPALIVE
 
@@ -132,7 +137,7 @@ using PlatformLoopCallback = void(*)();
 		attrs.alpha = false;
 		attrs.depth = true;
 		attrs.stencil = true;
-		attrs.antialias = true;
+		attrs.antialias = false;
 		attrs.premultipliedAlpha = false;
 		attrs.preserveDrawingBuffer = false;
 		attrs.powerPreference = false;
@@ -153,6 +158,26 @@ using PlatformLoopCallback = void(*)();
 		emscripten_webgl_make_context_current(context);
 	}
 
+	inline GLuint platform_get_main_framebuffer() {
+		return 0;
+	}
+
+	inline double platform_get_time() {
+		return emscripten_get_now() / 1000.0;
+	}
+
+	inline uint32_t platform_get_seed() {
+		return std::random_device {} ();
+	}
+
+	inline bool platform_has_timer_query() {
+		return emscripten_webgl_enable_extension(emscripten_webgl_get_current_context(), "EXT_disjoint_timer_query_webgl2");
+	}
+
+	inline bool platform_has_program_binary() {
+		return false;
+	}
+
 	inline void platform_write(std::string path, std::string data) {
 		std::string code = "localStorage.setItem('" + path + "', '" + data + "');";
 		emscripten_run_script(code.data());
@@ -173,7 +198,17 @@ using PlatformLoopCallback = void(*)();
 
 	// sudo apt-get install libopenal-dev
 
-	#include <winx.h>
+	#if defined(GAME_HEADLESS)
+		#include <EGL/egl.h>
+		#include <EGL/eglext.h>
+		#include <stb_image_write.h>
+	#else
+		#include <winx.h>
+
+		// the window thread only submits to GL, the game is simulated on a thread of its own
+		#define PLATFORM_RENDER_THREAD
+	#endif
+
 	#include <glad/glad.h>
 	#include <sys/stat.h>
 
@@ -186,43 +221,93 @@ using PlatformLoopCallback = void(*)();
 		extern PlatformKeyEventCallback keydown_callback;
 		extern PlatformKeyEventCallback keyup_callback;
 
-		/// translates the system keycode into key enum
-		inline Key platform_translate_key(int key) {
-
-			if (key == WXK_LEFT) return Key::LEFT;
-			if (key == WXK_RIGHT) return Key::RIGHT;
-			if (key == WXK_UP) return Key::UP;
-			if (key == WXK_DOWN) return Key::DOWN;
-			if (key == WXK_SPACE) return Key::SPACE;
-			if (key == WXK_ESC) return Key::ESCAPE;
-			if (key == WXK_TAB) return Key::TAB;
-			if (key == WXK_ENTER) return Key::ENTER;
-			if (key == 'W' || key == 'w') return Key::W;
-			if (key == 'A' || key == 'a') return Key::A;
-			if (key == 'D' || key == 'd') return Key::D;
-			if (key == 'B' || key == 'b') return Key::B;
+		#if defined(GAME_HEADLESS)
 
-			return Key::UNDEF;
-		}
+			extern GLuint main_framebuffer;
+			extern int frame;
 
-		inline void platform_close_handler() {
-			exit(-1);
-		}
+			/// read integer from the environment, used to configure headless runs
+			inline int platform_env_int(const char* name, int fallback) {
+				const char* value = getenv(name);
+				return value ? atoi(value) : fallback;
+			}
+
+			/// press and release keys the way a player would, so that runs cover gameplay and not just the title screen
+			inline void platform_script_input(int frame) {
+
+				// the first shot starts the level, after that the player keeps firing while there is ammo
+				if (frame == 0) {
+					keydown_callback(Key::SPACE);
+				}
+
+				// weave across the screen, right, then left twice as long, then right again to end up where we started
+				switch (frame % 240) {
+					case 0: keydown_callback(Key::RIGHT); break;
+					case 40: keyup_callback(Key::RIGHT); break;
+					case 80: keydown_callback(Key::LEFT); break;
+					case 160: keyup_callback(Key::LEFT); break;
+					case 200: keydown_callback(Key::RIGHT); break;
+				}
+			}
+
+			/// write the contents of the offscreen screen into a PNG file
+			inline void platform_dump_frame(const std::string& path) {
+				std::vector<uint8_t> pixels (screen_width * screen_height * 4);
+				glBindFramebuffer(GL_READ_FRAMEBUFFER, main_framebuffer);
+				glReadPixels(0, 0, screen_width, screen_height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
 
-		inline void platform_keyboard_handler(int state, int keycode) {
-			Key key = platform_translate_key(keycode);
+				// OpenGL rows go bottom-up
+				stbi_flip_vertically_on_write(true);
 
-			if (state == WINX_PRESSED) {
-				keydown_callback(key);
-			} else {
-				keyup_callback(key);
+				if (!stbi_write_png(path.c_str(), screen_width, screen_height, 4, pixels.data(), screen_width * 4)) {
+					printf("Failed to write frame '%s'!\n", path.c_str());
+				}
 			}
-		}
 
-		inline void platform_resize_handler(int width, int height) {
-			screen_width = width;
-			screen_height = height;
-		}
+		#else
+
+			// set once the window is asked to close, the main loop returns after finishing the frame
+			extern bool quit;
+
+			/// translates the system keycode into key enum
+			inline Key platform_translate_key(int key) {
+
+				if (key == WXK_LEFT) return Key::LEFT;
+				if (key == WXK_RIGHT) return Key::RIGHT;
+				if (key == WXK_UP) return Key::UP;
+				if (key == WXK_DOWN) return Key::DOWN;
+				if (key == WXK_SPACE) return Key::SPACE;
+				if (key == WXK_ESC) return Key::ESCAPE;
+				if (key == WXK_TAB) return Key::TAB;
+				if (key == WXK_ENTER) return Key::ENTER;
+				if (key == 'W' || key == 'w') return Key::W;
+				if (key == 'A' || key == 'a') return Key::A;
+				if (key == 'D' || key == 'd') return Key::D;
+				if (key == 'B' || key == 'b') return Key::B;
+
+				return Key::UNDEF;
+			}
+
+			inline void platform_close_handler() {
+				quit = true;
+			}
+
+			inline void platform_keyboard_handler(int state, int keycode) {
+				Key key = platform_translate_key(keycode);
+
+				if (state == WINX_PRESSED) {
+					keydown_callback(key);
+				} else {
+					keyup_callback(key);
+				}
+			}
+
+			inline void platform_resize_handler(int width, int height) {
+				screen_width = width;
+				screen_height = height;
+			}
+
+		#endif
 
 		inline void platform_write_string(std::string path, std::string data) {
 			mkdir("./local", S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
@@ -274,34 +359,159 @@ using PlatformLoopCallback = void(*)();
 		*height = impl::screen_height;
 	}
 
-	[[noreturn]] inline void platform_set_main_loop(PlatformLoopCallback callback, int fps) {
-		while (true) {
-			callback();
+	#if defined(GAME_HEADLESS)
+
+		/// runs a fixed number of frames as fast as possible, and then returns
+		inline void platform_set_main_loop(PlatformLoopCallback callback, int fps) {
+			const int frames = impl::platform_env_int("HEADLESS_FRAMES", 600);
+			const int every = std::max(1, impl::platform_env_int("HEADLESS_DUMP_EVERY", 60));
+			const char* dump = getenv("HEADLESS_DUMP");
+			const bool script = impl::platform_env_int("HEADLESS_SCRIPT", 1);
+
+			for (impl::frame = 0; impl::frame < frames; impl::frame ++) {
+				if (script) {
+					impl::platform_script_input(impl::frame);
+				}
+
+				callback();
+
+				if (dump && (impl::frame % every == 0)) {
+					char name[32];
+					snprintf(name, sizeof(name), "/frame_%05d.png", impl::frame);
+					impl::platform_dump_frame(dump + std::string(name));
+				}
+			}
 
-			winxSwapBuffers();
-			winxPollEvents();
+			glFinish();
 		}
-	}
 
-	inline void platform_init() {
-		printf("Began 'Winx/OpenGL' platform init...\n");
+		inline void platform_init() {
+			printf("Began 'EGL/Headless' platform init...\n");
 
-		winxHint(WINX_HINT_VSYNC, WINX_VSYNC_ENABLED);
+			// Mesa's surfaceless platform needs no display server, it works with llvmpipe
+			auto get_platform_display = (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+			EGLDisplay display = get_platform_display ? get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr) : EGL_NO_DISPLAY;
 
-		if (!winxOpen(GAME_NATIVE_WIDTH, GAME_NATIVE_HEIGHT, GAME_TITLE)) {
-			printf("Failed to create WINX context! %s\n", winxGetError());
-			platform_exit(-1);
+			if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+				printf("Failed to open surfaceless EGL display!\n");
+				platform_exit(-1);
+			}
+
+			// configs default to window surfaces, which the surfaceless platform doesn't have
+			const EGLint config_attributes[] = {
+				EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+				EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+				EGL_NONE
+			};
+
+			const EGLint context_attributes[] = {
+				EGL_CONTEXT_MAJOR_VERSION, 3,
+				EGL_CONTEXT_MINOR_VERSION, 3,
+				EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+				EGL_NONE
+			};
+
+			EGLConfig config;
+			EGLint configs = 0;
+			eglBindAPI(EGL_OPENGL_API);
+
+			if (!eglChooseConfig(display, config_attributes, &config, 1, &configs) || configs == 0) {
+				printf("Failed to find EGL config!\n");
+				platform_exit(-1);
+			}
+
+			EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attributes);
+
+			if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+				printf("Failed to create EGL context!\n");
+				platform_exit(-1);
+			}
+
+			// use GLAD to load OpenGL functions
+			gladLoadGLLoader((GLADloadproc) eglGetProcAddress);
+
+			impl::screen_width = impl::platform_env_int("HEADLESS_WIDTH", GAME_NATIVE_WIDTH);
+			impl::screen_height = impl::platform_env_int("HEADLESS_HEIGHT", GAME_NATIVE_HEIGHT);
+
+			// there is no window, so the "screen" is a framebuffer of our own
+			GLuint color;
+			glGenRenderbuffers(1, &color);
+			glBindRenderbuffer(GL_RENDERBUFFER, color);
+			glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, impl::screen_width, impl::screen_height);
+
+			glGenFramebuffers(1, &impl::main_framebuffer);
+			glBindFramebuffer(GL_FRAMEBUFFER, impl::main_framebuffer);
+			glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color);
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		}
+
+		inline GLuint platform_get_main_framebuffer() {
+			return impl::main_framebuffer;
+		}
+
+		inline double platform_get_time() {
+
+			// runs need to be reproducible, so time advances by a fixed step every frame
+			return impl::frame / 60.0;
+		}
+
+		inline uint32_t platform_get_seed() {
+			return impl::platform_env_int("HEADLESS_SEED", 0);
 		}
 
-		// use GLAD to load OpenGL functions
-		gladLoadGL();
+	#else
 
-		impl::screen_width = GAME_NATIVE_WIDTH;
-		impl::screen_height = GAME_NATIVE_HEIGHT;
+		/// runs until the window is closed, and then returns
+		inline void platform_set_main_loop(PlatformLoopCallback callback, int fps) {
+			while (!impl::quit) {
+				callback();
+
+				winxSwapBuffers();
+				winxPollEvents();
+			}
+		}
+
+		inline void platform_init() {
+			printf("Began 'Winx/OpenGL' platform init...\n");
+
+			winxHint(WINX_HINT_VSYNC, WINX_VSYNC_ENABLED);
+
+			if (!winxOpen(GAME_NATIVE_WIDTH, GAME_NATIVE_HEIGHT, GAME_TITLE)) {
+				printf("Failed to create WINX context! %s\n", winxGetError());
+				platform_exit(-1);
+			}
+
+			// use GLAD to load OpenGL functions
+			gladLoadGL();
+
+			impl::screen_width = GAME_NATIVE_WIDTH;
+			impl::screen_height = GAME_NATIVE_HEIGHT;
+
+			winxSetCloseEventHandle(impl::platform_close_handler);
+			winxSetKeyboardEventHandle(impl::platform_keyboard_handler);
+			winxSetResizeEventHandle(impl::platform_resize_handler);
+		}
+
+		inline GLuint platform_get_main_framebuffer() {
+			return 0;
+		}
+
+		inline double platform_get_time() {
+			return std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		inline uint32_t platform_get_seed() {
+			return std::random_device {} ();
+		}
+
+	#endif
+
+	inline bool platform_has_timer_query() {
+		return GLAD_GL_VERSION_3_3 || GLAD_GL_ARB_timer_query;
+	}
 
-		winxSetCloseEventHandle(impl::platform_close_handler);
-		winxSetKeyboardEventHandle(impl::platform_keyboard_handler);
-		winxSetResizeEventHandle(impl::platform_resize_handler);
+	inline bool platform_has_program_binary() {
+		return GLAD_GL_VERSION_4_1 || GLAD_GL_ARB_get_program_binary;
 	}
 
 #endif
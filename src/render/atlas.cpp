@@ -0,0 +1,162 @@
+
+#include "atlas.hpp"
+
+/*
+ * Atlas
+ */
+
+void Atlas::uploadTable() {
+	const int rows = (sprites.size() + table_width - 1) / table_width;
+	std::vector<float> data(table_width * rows * 4, 0.0f);
+
+	for (size_t i = 0; i < sprites.size(); i ++) {
+		const Sprite& sprite = sprites[i];
+
+		data[i * 4 + 0] = sprite.min_u;
+		data[i * 4 + 1] = sprite.min_v;
+		data[i * 4 + 2] = sprite.max_u;
+		data[i * 4 + 3] = sprite.max_v;
+	}
+
+	table.init();
+	table.setResource(GpuResource::TEXTURE, "sprite table");
+	table.upload(data.data(), table_width, rows, GL_RGBA32F, GL_RGBA, GL_FLOAT);
+}
+
+void Atlas::close() {
+	texture.close();
+	table.close();
+}
+
+void Atlas::add(TileSet& tileset, const char* path, uint32_t tile) {
+	add(tileset, path, tile, tile);
+}
+
+void Atlas::add(TileSet& tileset, const char* path, uint32_t tw, uint32_t th) {
+	sheets.push_back({&tileset, path, tw, th});
+}
+
+void Atlas::pack() {
+
+	struct Image {
+		uint32_t* pixels;
+		int width, height;
+		int columns, rows;
+		int x = 0, y = 0;
+	};
+
+	std::vector<Image> images;
+	int atlas_width = 0;
+
+	for (const Sheet& sheet : sheets) {
+		int32_t width, height, channels;
+		uint8_t* data = stbi_load(sheet.path.c_str(), &width, &height, &channels, 4);
+
+		if (data == nullptr) {
+			fault("Failed to load texture: '%s'!\n", sheet.path.c_str());
+		}
+
+		if (width % sheet.tw != 0 || height % sheet.th != 0) {
+			fault("Unable to neatly divide tileset! Texture width: %d tile width: %d\n", width, sheet.tw);
+		}
+
+		Image& image = images.emplace_back();
+		image.pixels = (uint32_t*) data;
+		image.width = width;
+		image.height = height;
+		image.columns = width / sheet.tw;
+		image.rows = height / sheet.th;
+
+		atlas_width = std::max<int>(atlas_width, image.columns * (sheet.tw + padding * 2));
+	}
+
+	// place sheets in rows (shelves) from left to right, there are only a few of them so this is good enough
+	atlas_width = std::bit_ceil((uint32_t) atlas_width);
+	int x = 0, y = 0, shelf = 0;
+
+	for (size_t i = 0; i < images.size(); i ++) {
+		Image& image = images[i];
+
+		const int block_width = image.columns * (sheets[i].tw + padding * 2);
+		const int block_height = image.rows * (sheets[i].th + padding * 2);
+
+		if (x + block_width > atlas_width) {
+			x = 0;
+			y += shelf;
+			shelf = 0;
+		}
+
+		image.x = x;
+		image.y = y;
+
+		x += block_width;
+		shelf = std::max(shelf, block_height);
+	}
+
+	const int atlas_height = std::bit_ceil((uint32_t) (y + shelf));
+	std::vector<uint32_t> pixels(atlas_width * atlas_height, 0);
+	sprites.clear();
+
+	for (size_t i = 0; i < images.size(); i ++) {
+		const Image& image = images[i];
+		const int tw = sheets[i].tw;
+		const int th = sheets[i].th;
+		const int cw = tw + padding * 2;
+		const int ch = th + padding * 2;
+
+		sheets[i].tileset->init(*this, sprites.size(), tw, th, image.columns, image.rows);
+
+		for (int ty = 0; ty < image.rows; ty ++) {
+			for (int tx = 0; tx < image.columns; tx ++) {
+				const int ox = image.x + tx * cw;
+				const int oy = image.y + ty * ch;
+
+				// copy the sprite, stretching its edge pixels into the padding
+				for (int cy = 0; cy < ch; cy ++) {
+					for (int cx = 0; cx < cw; cx ++) {
+						const int sx = tx * tw + std::clamp(cx - padding, 0, tw - 1);
+						const int sy = ty * th + std::clamp(cy - padding, 0, th - 1);
+
+						pixels[(oy + cy) * atlas_width + ox + cx] = image.pixels[sy * image.width + sx];
+					}
+				}
+
+				sprites.emplace_back(
+					(ox + padding) / (float) atlas_width,
+					(oy + padding) / (float) atlas_height,
+					(ox + padding + tw) / (float) atlas_width,
+					(oy + padding + th) / (float) atlas_height
+				);
+			}
+		}
+
+		stbi_image_free(image.pixels);
+	}
+
+	texture.init();
+	texture.setResource(GpuResource::TEXTURE, "atlas");
+	texture.upload((uint8_t*) pixels.data(), atlas_width, atlas_height, 4);
+	uploadTable();
+	sheets.clear();
+}
+
+void Atlas::use() const {
+	table.use(1);
+	texture.use(0);
+}
+
+const Sprite& Atlas::sprite(uint32_t cell) const {
+	return sprites[cell];
+}
+
+const Texture& Atlas::getTexture() const {
+	return texture;
+}
+
+uint32_t Atlas::width() const {
+	return texture.width();
+}
+
+uint32_t Atlas::height() const {
+	return texture.height();
+}
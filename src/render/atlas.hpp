@@ -0,0 +1,62 @@
+#pragma once
+
+#include <external.hpp>
+#include "texture.hpp"
+
+/// Single texture holding all sprite sheets, with one sprite table shared between them
+class Atlas {
+
+	public:
+
+		/// Pixels of bleed around each sprite, keeps nearest sampling from reaching into the neighbours
+		static constexpr int padding = 1;
+
+		/// Width of the sprite table texture, must match the one in sprite.vert
+		static constexpr int table_width = 256;
+
+	private:
+
+		struct Sheet {
+			TileSet* tileset;
+			std::string path;
+			uint32_t tw, th;
+		};
+
+		std::vector<Sheet> sheets;
+		std::vector<Sprite> sprites;
+
+		Texture texture;
+		Texture table;
+
+		/// Upload sprite UVs so that the sprite shader can look them up
+		void uploadTable();
+
+	public:
+
+		Atlas() = default;
+
+		void close();
+
+		/// Add a sprite sheet, the tileset is initialized once the atlas is packed
+		void add(TileSet& tileset, const char* path, uint32_t tile);
+		void add(TileSet& tileset, const char* path, uint32_t tw, uint32_t th);
+
+		/// Pack all added sheets and upload the result
+		void pack();
+
+		/// Bind the atlas to texture unit 0 and the sprite table to unit 1
+		void use() const;
+
+		/// Get the sprite at the given sprite table cell
+		const Sprite& sprite(uint32_t cell) const;
+
+		/// Get the packed texture
+		const Texture& getTexture() const;
+
+		/// Get atlas width in pixels
+		uint32_t width() const;
+
+		/// Get atlas height in pixels
+		uint32_t height() const;
+
+};
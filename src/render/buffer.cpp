@@ -1,37 +1,227 @@
 
 #include "buffer.hpp"
 #include "layout.hpp"
+#include "stats.hpp"
+#include "state.hpp"
+
+/*
+ * QuadIndexBuffer
+ */
+
+template <typename T>
+void QuadIndexBuffer::build(uint32_t quads) {
+	std::vector<T> pattern;
+	pattern.reserve(quads * 6);
+
+	for (uint32_t i = 0; i < quads; i ++) {
+		const T base = i * 4;
+
+		pattern.push_back(base + 0);
+		pattern.push_back(base + 1);
+		pattern.push_back(base + 2);
+		pattern.push_back(base + 2);
+		pattern.push_back(base + 3);
+		pattern.push_back(base + 0);
+	}
+
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, pattern.size() * sizeof(T), pattern.data(), GL_STATIC_DRAW);
+
+	memory.resize(pattern.size() * sizeof(T));
+}
+
+void QuadIndexBuffer::init() {
+	glGenBuffers(1, &ebo);
+}
+
+void QuadIndexBuffer::close() {
+	memory.resize(0);
+
+	glDeleteBuffers(1, &ebo);
+}
+
+void QuadIndexBuffer::reserve(uint32_t quads) {
+	if (quads <= this->quads) {
+		return;
+	}
+
+	// round up to the next power of two, so that we don't rebuild too often
+	this->quads = std::bit_ceil(quads);
+	use();
+
+	// prefer short indices while they can address all vertices, they are half the size
+	if (this->quads * 4 <= std::numeric_limits<uint16_t>::max() + 1) {
+		type = GL_UNSIGNED_SHORT;
+		build<uint16_t>(this->quads);
+	} else {
+		type = GL_UNSIGNED_INT;
+		build<uint32_t>(this->quads);
+	}
+}
+
+void QuadIndexBuffer::use() const {
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+}
+
+GLenum QuadIndexBuffer::getType() const {
+	return type;
+}
+
+uint32_t QuadIndexBuffer::getSize() const {
+	return type == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+}
 
 /*
  * VertexBuffer
  */
 
-void VertexBuffer::init(const Layout& layout, GLenum type) {
+void VertexBuffer::reserve(size_t size) {
+
+	// leave some headroom so that we don't reallocate on every small increase,
+	// capacity needs to be a multiple of a quad so that regions start at a quad boundary
+	const size_t vertices = ((size + size / 2) / stride / 4 + 1) * 4;
+	capacity = vertices * stride;
+	region = 0;
+
+	// this also orphans the old storage, any pending draws will still use it
+	glBufferData(GL_ARRAY_BUFFER, capacity * regions, nullptr, type);
+	RenderStats::getInstance().frame().grows ++;
+	memory.resize(capacity * regions);
+
+	// the element buffer is indexed with absolute vertex positions, it needs to cover all regions
+	if (indices) {
+		bindVertexArray(vao);
+		indices->reserve(vertices * regions / 4);
+	}
+}
+
+void VertexBuffer::init(const Layout& layout, GLenum type, QuadIndexBuffer* indices) {
 	// create and bind VAO
 	glGenVertexArrays(1, &vao);
-	glBindVertexArray(vao);
+	bindVertexArray(vao);
 
 	// create and bind VBO
 	glGenBuffers(1, &vbo);
-	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	bindArrayBuffer(vbo);
+
+	// element buffer binding is a part of the VAO state
+	if (indices) {
+		indices->use();
+	}
 
 	// configure VAO
 	this->stride = layout.apply();
 	this->type = type;
+	this->indices = indices;
 }
 
 void VertexBuffer::close() {
+	memory.resize(0);
 	glDeleteVertexArrays(1, &vao);
 	glDeleteBuffers(1, &vbo);
+	invalidateBindings();
+}
+
+void VertexBuffer::setLabel(const char* label) {
+	memory.relabel(GpuResource::BUFFER, label);
 }
 
 void VertexBuffer::upload(uint8_t* data, size_t size) {
-	glBindBuffer(GL_ARRAY_BUFFER, vbo);
-	glBufferData(GL_ARRAY_BUFFER, size, data, type);
+	bindArrayBuffer(vbo);
 	vertices = size / stride;
+	RenderStats::getInstance().frame().uploaded += size;
+
+	// static buffers are written once, there is nothing to stream
+	if (type == GL_STATIC_DRAW) {
+		glBufferData(GL_ARRAY_BUFFER, size, data, type);
+		memory.resize(size);
+
+		if (indices) {
+			bindVertexArray(vao);
+			indices->reserve(vertices / 4);
+		}
+
+		return;
+	}
+
+	if (size > capacity) {
+		reserve(size);
+	} else {
+		region = (region + 1) % regions;
+	}
+
+	const size_t offset = region * capacity;
+	first = offset / stride;
+
+	if (size == 0) {
+		return;
+	}
+
+	// WebGL has no way of mapping buffers, emscripten only emulates it with a copy
+	#if !defined(__EMSCRIPTEN__)
+		const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+
+		if (void* target = glMapBufferRange(GL_ARRAY_BUFFER, offset, size, access)) {
+			memcpy(target, data, size);
+
+			// if the unmap fails the storage got corrupted, just upload it again
+			if (glUnmapBuffer(GL_ARRAY_BUFFER)) {
+				return;
+			}
+		}
+	#endif
+
+	glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
 }
 
 void VertexBuffer::draw() {
-	glBindVertexArray(vao);
-	glDrawArrays(GL_TRIANGLES, 0, vertices);
-}
\ No newline at end of file
+	draw(0, vertices);
+}
+
+void VertexBuffer::draw(uint32_t offset, uint32_t count) {
+	if (count == 0) {
+		return;
+	}
+
+	bindVertexArray(vao);
+	RenderStats::getInstance().frame().draws ++;
+
+	if (indices) {
+
+		// the index pattern is periodic, so we can start drawing from the
+		// current region by skipping the indices of all the preceding quads
+		const size_t start = ((first + offset) / 4) * 6 * indices->getSize();
+		glDrawElements(GL_TRIANGLES, (count / 4) * 6, indices->getType(), reinterpret_cast<void*>(start));
+		return;
+	}
+
+	glDrawArrays(GL_TRIANGLES, first + offset, count);
+}
+
+/*
+ * InstanceBuffer
+ */
+
+void InstanceBuffer::init(const Layout& layout, GLenum type) {
+	VertexBuffer::init(layout, type);
+	this->layout = &layout;
+}
+
+void InstanceBuffer::draw() {
+	draw(0, vertices);
+}
+
+void InstanceBuffer::draw(uint32_t offset, uint32_t count) {
+	if (count == 0) {
+		return;
+	}
+
+	bindVertexArray(vao);
+	RenderStats::getInstance().frame().draws ++;
+
+	// there is no base instance in WebGL 2, so point the attributes at the first instance instead
+	bindArrayBuffer(vbo);
+	layout->apply((first + offset) * stride);
+
+	// quad corners are generated in the shader from the vertex ID
+	glDrawArraysInstanced(GL_TRIANGLES, 0, 6, count);
+}
@@ -1,32 +1,113 @@
 #pragma once
 
 #include <external.hpp>
+#include "stats.hpp"
 
 class Layout;
 
-class VertexBuffer {
+/// Static element buffer holding the repeating quad pattern, can be shared between vertex buffers
+class QuadIndexBuffer {
 
 	private:
 
+		GLuint ebo = 0;
+		uint32_t quads = 0;
+		GLenum type = GL_UNSIGNED_SHORT;
+		GpuAllocation memory {GpuResource::BUFFER, "quad indices"};
+
+		template <typename T>
+		void build(uint32_t quads);
+
+	public:
+
+		QuadIndexBuffer() = default;
+
+		void init();
+		void close();
+
+		/// Make sure the pattern covers at least the given number of quads
+		void reserve(uint32_t quads);
+
+		/// Bind this buffer to the currently bound VAO
+		void use() const;
+
+		/// Get the OpenGL type of a single index
+		GLenum getType() const;
+
+		/// Get the size of a single index in bytes
+		uint32_t getSize() const;
+
+};
+
+class VertexBuffer {
+
+	public:
+
+		/// Number of regions a streaming buffer is split into
+		static constexpr uint32_t regions = 3;
+
+	protected:
+
 		GLuint vao = 0;
 		GLuint vbo = 0;
+		NULLABLE QuadIndexBuffer* indices = nullptr;
 		uint32_t stride = 0;
 		uint32_t vertices = 0;
 		GLenum type = 0;
 
+		// streaming buffers are written into one region per frame, in a round-robin
+		// fashion, so that we never overwrite data the GPU may still be reading from
+		uint32_t region = 0;
+		uint32_t first = 0;
+		size_t capacity = 0;
+
+		// storage held on the GPU, as reported to the render stats
+		GpuAllocation memory {GpuResource::BUFFER, "vertices"};
+
+		/// Reallocate GPU storage so that each region can hold at least size bytes
+		void reserve(size_t size);
+
 	public:
 
 		VertexBuffer() = default;
 
-		void init(const Layout& layout, GLenum type);
+		/// If the index buffer is given, vertices are drawn as quads, 4 vertices each
+		void init(const Layout& layout, GLenum type, NULLABLE QuadIndexBuffer* indices = nullptr);
 		void close();
 
+		/// Change the label this buffer is reported under in the memory stats
+		void setLabel(const char* label);
+
 		/// Upload given data to the GPU
 		void upload(uint8_t* data, size_t size);
 
 		/// Draw buffer data using bound shader
 		void draw();
 
+		/// Draw a range of vertices using bound shader, offset is relative to the last upload
+		void draw(uint32_t offset, uint32_t count);
+
+};
+
+/// Vertex buffer holding per-instance data, each instance is expanded into a quad by the vertex shader
+class InstanceBuffer : public VertexBuffer {
+
+	private:
+
+		const Layout* layout = nullptr;
+
+	public:
+
+		InstanceBuffer() = default;
+
+		void init(const Layout& layout, GLenum type);
+
+		/// Draw one quad per instance using bound shader
+		void draw();
+
+		/// Draw a range of instances using bound shader, offset is relative to the last upload
+		void draw(uint32_t offset, uint32_t count);
+
 };
 
 template <typename V>
@@ -37,6 +118,17 @@ class BufferWriter {
 		std::vector<V> vertices;
 		VertexBuffer* buffer = nullptr;
 
+		// the most vertices written in a single frame so far
+		size_t high = 0;
+
+		void reset() {
+			high = std::max(high, vertices.size());
+
+			// keep the storage around, next frame will most likely need just as much
+			vertices.clear();
+			vertices.reserve(high);
+		}
+
 	public:
 
 		BufferWriter() = default;
@@ -50,10 +142,20 @@ class BufferWriter {
 			vertices.push_back(vertex);
 		}
 
+		/// Write a batch of vertices to buffer
+		void push(const std::vector<V>& batch) {
+			vertices.insert(vertices.end(), batch.begin(), batch.end());
+		}
+
+		/// Write a range of vertices to buffer
+		void push(const V* data, size_t count) {
+			vertices.insert(vertices.end(), data, data + count);
+		}
+
 		/// Upload written data to the underlying buffer
 		void upload() {
 			buffer->upload((uint8_t*) vertices.data(), vertices.size() * sizeof(V));
-			vertices.clear();
+			reset();
 		}
 
 };
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <external.hpp>
+
+/// Get the contents of an asset embedded into the binary at build time, empty if there is no such file
+std::string_view getEmbeddedFile(std::string_view path);
@@ -1,5 +1,6 @@
 
 #include "framebuffer.hpp"
+#include "state.hpp"
 
 void Framebuffer::init() {
 	glGenFramebuffers(1, &fbo);
@@ -12,6 +13,7 @@ void Framebuffer::init(int fbo) {
 void Framebuffer::close() {
 	if (fbo != 0) {
 		glDeleteFramebuffers(1, &fbo);
+		invalidateBindings();
 	}
 }
 
@@ -20,8 +22,13 @@ void Framebuffer::attach(const PixelBuffer& buffer, GLenum attachment) {
 	buffer.framebuffer(attachment);
 }
 
+void Framebuffer::detach(GLenum attachment) {
+	use();
+	glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, 0, 0);
+}
+
 void Framebuffer::use() const {
-	glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+	bindFramebuffer(fbo);
 }
 
 void Framebuffer::clear(GLbitfield mask) const {
@@ -29,9 +36,14 @@ void Framebuffer::clear(GLbitfield mask) const {
 	glClear(mask);
 }
 
+void Framebuffer::blit(const Framebuffer& target, int sx, int sy, int sw, int sh, int tx, int ty, int tw, int th, GLenum filter) const {
+	bindFramebuffers(fbo, target.fbo);
+	glBlitFramebuffer(sx, sy, sx + sw, sy + sh, tx, ty, tx + tw, ty + th, GL_COLOR_BUFFER_BIT, filter);
+}
+
 const Framebuffer& Framebuffer::main() {
 	static Framebuffer fb;
-	fb.init(0);
+	fb.init(platform_get_main_framebuffer());
 
 	return fb;
 }
\ No newline at end of file
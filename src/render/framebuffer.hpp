@@ -20,12 +20,18 @@ class Framebuffer {
 		/// Add a pixel buffer to back this framebuffer
 		void attach(const PixelBuffer& buffer, GLenum attachment);
 
+		/// Remove the pixel buffer backing the given attachment
+		void detach(GLenum attachment);
+
 		/// Bind this framebuffer
 		void use() const;
 
 		/// Clear this framebuffer
 		void clear(GLbitfield mask = GL_COLOR_BUFFER_BIT) const;
 
+		/// Copy a rectangle of this framebuffer into the given one, scaling it if the sizes differ
+		void blit(const Framebuffer& target, int sx, int sy, int sw, int sh, int tx, int ty, int tw, int th, GLenum filter = GL_LINEAR) const;
+
 	public:
 
 		/// Get reference to the main screen framebuffer
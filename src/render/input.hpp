@@ -57,9 +57,16 @@ class Input {
 			return state;
 		}
 
+		// events come from the window thread, while the game can be ticking on another one
+		static std::mutex& mutex() {
+			static std::mutex mutex;
+			return mutex;
+		}
+
 	public:
 
 		static void press(Key code) {
+			std::lock_guard lock {mutex()};
 			KeyState& ks = state().get(code);
 			ks = (ks == KeyState::UP) ? KeyState::TYPED : KeyState::DOWN;
 
@@ -69,29 +76,35 @@ class Input {
 		}
 
 		static void release(Key code) {
+			std::lock_guard lock {mutex()};
 			state().get(code) = KeyState::UP;
 		}
 
 		static void move(float x, float y) {
+			std::lock_guard lock {mutex()};
 			state().move(x, y);
 		}
 
 		static void clear() {
+			std::lock_guard lock {mutex()};
 			state().clear();
 		}
 
 	public:
 
 		static bool isPressed(Key code) {
+			std::lock_guard lock {mutex()};
 			return state().get(code) != KeyState::UP;
 		}
 
 		static void purge() {
+			std::lock_guard lock {mutex()};
 			state().history.clear();
 		}
 
 		template<typename... Keys>
 		static bool matchKeys(Keys... codes) {
+			std::lock_guard lock {mutex()};
 			std::array<Key, sizeof...(codes)> keys = {codes...};
 
 			if (state().history.size() < keys.size()) {
@@ -33,11 +33,12 @@ uint32_t Layout::size() const {
 	return size;
 }
 
-uint32_t Layout::apply() const {
+uint32_t Layout::apply(size_t offset) const {
 	const uint32_t stride = size();
 
 	for (const Layout::Attribute& attr : attributes) {
-		glVertexAttribPointer(attr.index, attr.count, attr.type, attr.normalize, stride, reinterpret_cast<void*>(attr.offset));
+		glVertexAttribPointer(attr.index, attr.count, attr.type, attr.normalize, stride, reinterpret_cast<void*>(attr.offset + offset));
+		glVertexAttribDivisor(attr.index, divisor);
 		glEnableVertexAttribArray(attr.index);
 	}
 
@@ -47,4 +48,8 @@ uint32_t Layout::apply() const {
 void Layout::attribute(int index, int count, GLenum type, bool normalize) {
 	const int offset = size();
 	attributes.emplace_back(index, count, type, normalize, glTypeSize(type) * count, offset);
+}
+
+void Layout::instanced(uint32_t divisor) {
+	this->divisor = divisor;
 }
\ No newline at end of file
@@ -10,6 +10,7 @@ class Layout {
 		int glTypeSize(GLenum type);
 
 		friend class VertexBuffer;
+		friend class InstanceBuffer;
 
 		struct Attribute {
 			int index;
@@ -23,13 +24,17 @@ class Layout {
 		};
 
 		std::vector<Attribute> attributes;
+		uint32_t divisor = 0;
 
 		uint32_t size() const;
 
-		uint32_t apply() const;
+		uint32_t apply(size_t offset = 0) const;
 
 	public:
 
 		void attribute(int index, int count, GLenum type, bool normalize = false);
 
+		/// Advance all attributes once per given number of instances, instead of once per vertex
+		void instanced(uint32_t divisor = 1);
+
 };
\ No newline at end of file
@@ -0,0 +1,54 @@
+
+#include "pipeline.hpp"
+
+/*
+ * DrawPipeline
+ */
+
+DrawPipeline::DrawPipeline(Rectangle canvas) {
+	for (DrawList& list : lists) {
+		list.canvas = canvas;
+	}
+}
+
+DrawList* DrawPipeline::acquire() {
+	std::unique_lock lock {mutex};
+
+	// the list still being drawn counts as in flight, so this waits until it is released
+	changed.wait(lock, [&] { return closed || written - drawn < lists.size(); });
+	return closed ? nullptr : &lists[written % lists.size()];
+}
+
+void DrawPipeline::submit() {
+	{
+		std::lock_guard lock {mutex};
+		written ++;
+	}
+
+	changed.notify_all();
+}
+
+DrawList* DrawPipeline::consume() {
+	std::unique_lock lock {mutex};
+
+	changed.wait(lock, [&] { return closed || written > drawn; });
+	return closed ? nullptr : &lists[drawn % lists.size()];
+}
+
+void DrawPipeline::release() {
+	{
+		std::lock_guard lock {mutex};
+		drawn ++;
+	}
+
+	changed.notify_all();
+}
+
+void DrawPipeline::close() {
+	{
+		std::lock_guard lock {mutex};
+		closed = true;
+	}
+
+	changed.notify_all();
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <external.hpp>
+#include "renderer.hpp"
+
+/// Hands draw lists over from the thread that emits them to the thread that owns the GL context,
+/// at most two frames are in flight, one being drawn and one waiting to be drawn
+class DrawPipeline {
+
+	private:
+
+		std::mutex mutex;
+		std::condition_variable changed;
+		std::array<DrawList, 2> lists;
+
+		// total number of lists handed over and drawn
+		uint64_t written = 0;
+		uint64_t drawn = 0;
+		bool closed = false;
+
+	public:
+
+		/// Lists start out with the given canvas size, afterwards they carry the size they were last drawn with
+		explicit DrawPipeline(Rectangle canvas);
+
+		/// Wait for a free list to emit the next frame into, returns null once the pipeline is closed
+		NULLABLE DrawList* acquire();
+
+		/// Pass the acquired list over to the drawing thread
+		void submit();
+
+		/// Wait for the next list to draw, returns null once the pipeline is closed
+		NULLABLE DrawList* consume();
+
+		/// Return the consumed list, so that it can be reused
+		void release();
+
+		/// Wake up and stop both threads
+		void close();
+
+};
@@ -0,0 +1,72 @@
+
+#include "pool.hpp"
+
+/*
+ * TargetPool
+ */
+
+void TargetPool::close() {
+	for (auto& entry : entries) {
+		entry->texture.close();
+	}
+
+	entries.clear();
+}
+
+Texture& TargetPool::acquire(int w, int h, GLenum internal_format, GLenum format, const char* label) {
+	Entry* resizable = nullptr;
+
+	for (auto& entry : entries) {
+		if (entry->used || entry->internal_format != internal_format) {
+			continue;
+		}
+
+		if (entry->texture.width() == (uint32_t) w && entry->texture.height() == (uint32_t) h) {
+			entry->used = true;
+			entry->texture.setResource(GpuResource::TARGET, label);
+			return entry->texture;
+		}
+
+		resizable = entry.get();
+	}
+
+	// reallocating the storage of an existing texture still saves us from creating a new object
+	if (resizable == nullptr) {
+		auto& entry = entries.emplace_back(std::make_unique<Entry>());
+		resizable = entry.get();
+		resizable->internal_format = internal_format;
+		resizable->format = format;
+		resizable->texture.init();
+	}
+
+	resizable->used = true;
+	resizable->texture.setResource(GpuResource::TARGET, label);
+	resizable->texture.resize(w, h, internal_format, format);
+	return resizable->texture;
+}
+
+void TargetPool::release(const Texture& texture) {
+	for (auto& entry : entries) {
+		if (&entry->texture == &texture) {
+			entry->used = false;
+			entry->idle = 0;
+
+			// idle targets still hold their storage until trimmed
+			entry->texture.setResource(GpuResource::TARGET, "pooled target");
+			return;
+		}
+	}
+
+	fault("Texture was not acquired from this pool!\n");
+}
+
+void TargetPool::trim() {
+	std::erase_if(entries, [] (auto& entry) {
+		if (entry->used || ++ entry->idle <= keep_frames) {
+			return false;
+		}
+
+		entry->texture.close();
+		return true;
+	});
+}
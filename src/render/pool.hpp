@@ -0,0 +1,44 @@
+#pragma once
+
+#include <external.hpp>
+#include "texture.hpp"
+
+/// Hands out offscreen color targets by size and format, released targets are kept for a while
+/// so that resolution changes that go back and forth don't have to reallocate them every time
+class TargetPool {
+
+	public:
+
+		/// Number of frames an unused target is kept for, before its storage is freed
+		static constexpr uint32_t keep_frames = 120;
+
+	private:
+
+		struct Entry {
+			Texture texture;
+			GLenum internal_format;
+			GLenum format;
+			bool used;
+			uint32_t idle; // frames since the target was released
+		};
+
+		// passes hold references to the textures, so the entries must never move
+		std::vector<std::unique_ptr<Entry>> entries;
+
+	public:
+
+		TargetPool() = default;
+
+		void close();
+
+		/// Get a target of the given size and format, the contents and sampling parameters are undefined,
+		/// until released the target is reported under the given label in the memory stats
+		Texture& acquire(int w, int h, GLenum internal_format, GLenum format, const char* label);
+
+		/// Return a target to the pool, it must no longer be attached to any framebuffer
+		void release(const Texture& texture);
+
+		/// Free targets that have not been used for a while, should be called once per frame
+		void trim();
+
+};
@@ -0,0 +1,100 @@
+
+#include "queue.hpp"
+
+/*
+ * RenderQueue
+ */
+
+void RenderQueue::sort() {
+	scratch.resize(items.size());
+
+	for (int shift = 0; shift < 64; shift += 8) {
+		std::array<uint32_t, 256> offsets {};
+
+		for (const Item& item : items) {
+			offsets[(item.key >> shift) & 0xFF] ++;
+		}
+
+		// all items share this digit, the pass would not move anything,
+		// this skips the unused bits and the fields everything leaves at zero
+		if (offsets[(items.front().key >> shift) & 0xFF] == items.size()) {
+			continue;
+		}
+
+		uint32_t total = 0;
+
+		for (uint32_t& offset : offsets) {
+			const uint32_t count = offset;
+			offset = total;
+			total += count;
+		}
+
+		for (const Item& item : items) {
+			scratch[offsets[(item.key >> shift) & 0xFF] ++] = item;
+		}
+
+		items.swap(scratch);
+	}
+}
+
+void RenderQueue::submit(uint64_t key, const SpriteInstance& instance) {
+	items.push_back({key | (uint64_t) RenderKind::SPRITE << 28, (uint32_t) sprites.size()});
+	sprites.push_back(instance);
+}
+
+void RenderQueue::submit(uint64_t key, const ArcInstance& instance) {
+	items.push_back({key | (uint64_t) RenderKind::ARC << 28, (uint32_t) arcs.size()});
+	arcs.push_back(instance);
+}
+
+void RenderQueue::swap(RenderQueue& other) {
+	items.swap(other.items);
+	quads.swap(other.quads);
+	std::swap(stride, other.stride);
+	sprites.swap(other.sprites);
+	arcs.swap(other.arcs);
+}
+
+const std::vector<RenderBatch>& RenderQueue::flush(BufferWriter<uint8_t>& quad_writer, BufferWriter<SpriteInstance>& sprite_writer, BufferWriter<ArcInstance>& arc_writer) {
+	batches.clear();
+
+	if (items.empty()) {
+		return batches;
+	}
+
+	sort();
+
+	// counts of quads and instances written so far
+	uint32_t written[3] = {0, 0, 0};
+	uint64_t state = ~0ull;
+
+	for (const Item& item : items) {
+
+		// everything below depth selects the render state
+		const uint64_t current = (item.key >> 28) & 0xFFF;
+		const RenderKind kind = (RenderKind) (current & 0xF);
+
+		if (current != state) {
+			state = current;
+			batches.push_back({kind, (BlendMode) ((current >> 8) & 0xF), (uint8_t) ((current >> 4) & 0xF), written[(int) kind], 0});
+		}
+
+		if (kind == RenderKind::QUAD) {
+			quad_writer.push(quads.data() + item.index * 4 * stride, 4 * stride);
+		} else if (kind == RenderKind::SPRITE) {
+			sprite_writer.push(sprites[item.index]);
+		} else {
+			arc_writer.push(arcs[item.index]);
+		}
+
+		written[(int) kind] ++;
+		batches.back().count ++;
+	}
+
+	items.clear();
+	quads.clear();
+	sprites.clear();
+	arcs.clear();
+
+	return batches;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <external.hpp>
+#include "buffer.hpp"
+#include "state.hpp"
+#include "vertex.hpp"
+
+/// Kind of geometry a render queue item is made of, each kind has its own buffer and shader
+enum struct RenderKind : uint8_t {
+	QUAD   = 0, // four vertices in the geometry vertex format
+	SPRITE = 1, // a single SpriteInstance
+	ARC    = 2, // a single ArcInstance
+};
+
+/// Run of sorted render queue items that can be drawn with a single draw call
+struct RenderBatch {
+
+	RenderKind kind;
+	BlendMode blend;
+	uint8_t texture;
+
+	uint32_t first; // first quad or instance in the buffer of its kind
+	uint32_t count; // number of quads or instances
+
+};
+
+/// Collects everything drawn in a frame and orders it by sort key
+class RenderQueue {
+
+	public:
+
+		/// Build sort key, items are drawn in ascending key order, and in submission order if the keys are equal
+		static constexpr uint64_t key(uint8_t layer, uint16_t depth, BlendMode blend, uint8_t texture) {
+			// from the most significant bits: layer (8) | depth (16) | blend (4) | texture (4) | kind (4) | unused (28),
+			// the kind is filled in on submission, render state goes last so that it only groups items of equal depth
+			return ((uint64_t) layer << 56) | ((uint64_t) depth << 40) | ((uint64_t) blend << 36) | ((uint64_t) (texture & 0xF) << 32);
+		}
+
+	private:
+
+		struct Item {
+			uint64_t key;
+			uint32_t index;
+		};
+
+		std::vector<Item> items;
+		std::vector<Item> scratch;
+		// quads are stored as written, in whatever vertex format the layer packed them into
+		std::vector<uint8_t> quads;
+		uint32_t stride = 0;
+		std::vector<SpriteInstance> sprites;
+		std::vector<ArcInstance> arcs;
+		std::vector<RenderBatch> batches;
+
+		/// Stable LSD radix sort of the items by key
+		void sort();
+
+	public:
+
+		RenderQueue() = default;
+
+		/// Submit a quad, the vertices need to be in the order of the quad index pattern, all quads of a frame need to use the same vertex type
+		template <typename V>
+		void submit(uint64_t key, const V& a, const V& b, const V& c, const V& d) {
+			const size_t offset = quads.size();
+
+			items.push_back({key | (uint64_t) RenderKind::QUAD << 28, (uint32_t) (offset / (4 * sizeof(V)))});
+			stride = sizeof(V);
+
+			quads.resize(offset + 4 * sizeof(V));
+			uint8_t* target = quads.data() + offset;
+
+			memcpy(target + 0 * sizeof(V), &a, sizeof(V));
+			memcpy(target + 1 * sizeof(V), &b, sizeof(V));
+			memcpy(target + 2 * sizeof(V), &c, sizeof(V));
+			memcpy(target + 3 * sizeof(V), &d, sizeof(V));
+		}
+
+		/// Submit a sprite instance
+		void submit(uint64_t key, const SpriteInstance& instance);
+
+		/// Submit an electric arc instance
+		void submit(uint64_t key, const ArcInstance& instance);
+
+		/// Exchange submitted items with the other queue, used to hand a frame over without copying it
+		void swap(RenderQueue& other);
+
+		/// Sort all submitted items and write them into the writers in order, the queue is empty afterwards
+		const std::vector<RenderBatch>& flush(BufferWriter<uint8_t>& quads, BufferWriter<SpriteInstance>& sprites, BufferWriter<ArcInstance>& arcs);
+
+};
@@ -1,21 +1,154 @@
 #include "renderer.hpp"
 
 #include "state.hpp"
+#include "stats.hpp"
 
 /*
  * RenderLayer
  */
 
-void RenderLayer::init(BufferWriter<Vert4f4b>* writer, TileSet* tileset) {
-	this->writer = writer;
+void RenderLayer::init(RenderQueue* queue, TileSet* tileset, LayerOrder order, VertexFormat format, BlendMode blend) {
+	this->queue = queue;
 	this->tileset = tileset;
+	this->order = order;
+	this->format = format;
+	this->blend = blend;
+}
+
+void RenderLayer::quad(const Vert4f4b& a, const Vert4f4b& b, const Vert4f4b& c, const Vert4f4b& d, uint16_t depth) {
+	const uint64_t key = RenderQueue::key((uint8_t) order, depth, blend, 0);
+
+	// packed as it's written, so that the full vertices never reach the queue or the GPU buffers
+	if (format == VertexFormat::COMPACT) {
+		queue->submit(key, Vert2s2us4b {a}, Vert2s2us4b {b}, Vert2s2us4b {c}, Vert2s2us4b {d});
+		return;
+	}
+
+	queue->submit(key, a, b, c, d);
+}
+
+void RenderLayer::quads(const Vert4f4b* vertices, size_t count, uint16_t depth) {
+	for (size_t i = 0; i < count; i ++) {
+		const Vert4f4b* quad = vertices + i * 4;
+		this->quad(quad[0], quad[1], quad[2], quad[3], depth);
+	}
+}
+
+void RenderLayer::sprite(const SpriteInstance& instance, uint16_t depth) {
+	queue->submit(RenderQueue::key((uint8_t) order, depth, blend, 0), instance);
+}
+
+void RenderLayer::arc(const ArcInstance& instance, uint16_t depth) {
+	queue->submit(RenderQueue::key((uint8_t) order, depth, blend, 0), instance);
+}
+
+void RenderLayer::sprites(const std::vector<SpriteInstance>& batch, uint16_t depth) {
+	const uint64_t key = RenderQueue::key((uint8_t) order, depth, blend, 0);
+
+	for (const SpriteInstance& instance : batch) {
+		queue->submit(key, instance);
+	}
 }
 
 /*
  * Renderer
  */
 
-Renderer::Renderer() {
+// size of the precomputed CRT curvature texture
+static constexpr int lut_size = 256;
+
+// texels per unit of noise space in the electric arc noise texture
+static constexpr int noise_density = 8;
+
+// share of the frame budget the CRT effect is allowed to take
+static constexpr float crt_budget = 0.25f;
+
+// number of times each CRT quality is drawn when measuring it
+static constexpr int calibration_runs = 8;
+
+static const char* crt_quality_key = "crt";
+
+static const char* getQualityName(CrtQuality quality) {
+	switch (quality) {
+		case CrtQuality::OFF: return "off";
+		case CrtQuality::REDUCED: return "reduced";
+		case CrtQuality::FULL: return "full";
+	}
+
+	return "full";
+}
+
+/// Same curvature and vignette as computed by degrade.frag
+static std::vector<float> getCurveTable() {
+	std::vector<float> table;
+	table.reserve(lut_size * lut_size * 4);
+
+	for (int y = 0; y < lut_size; y ++) {
+		for (int x = 0; x < lut_size; x ++) {
+			float u = (x + 0.5f) / lut_size;
+			float v = (y + 0.5f) / lut_size;
+
+			u = (u - 0.5f) * 2.0f * 1.1f;
+			v = (v - 0.5f) * 2.0f * 1.1f;
+
+			const float cu = u * (1.0f + std::pow(std::abs(v) / 5.0f, 2.0f));
+			const float cv = v * (1.0f + std::pow(std::abs(cu) / 4.0f, 2.0f));
+
+			u = (cu / 2.0f + 0.5f) * 0.92f + 0.04f;
+			v = (cv / 2.0f + 0.5f) * 0.92f + 0.04f;
+
+			const bool inside = u >= 0.0f && u <= 1.0f && v >= 0.0f && v <= 1.0f;
+			const float vignette = 16.0f * u * v * (1.0f - u) * (1.0f - v);
+
+			table.push_back(u);
+			table.push_back(v);
+			table.push_back(inside ? std::pow(std::max(vignette, 0.0f), 0.3f) : 0.0f);
+			table.push_back(1.0f);
+		}
+	}
+
+	return table;
+}
+
+/// Periodic gradient noise sampled by arc.frag, one row per unit of the phase
+static std::vector<float> getNoiseTable() {
+	const int width = ArcInstance::period_x * noise_density;
+	const int height = ArcInstance::period_y * noise_density;
+	const glm::vec2 period {ArcInstance::period_x, ArcInstance::period_y};
+
+	std::vector<float> table;
+	table.reserve(width * height);
+
+	for (int y = 0; y < height; y ++) {
+		for (int x = 0; x < width; x ++) {
+			table.push_back(glm::perlin(glm::vec2 {x, y} / (float) noise_density, period));
+		}
+	}
+
+	return table;
+}
+
+void Renderer::drawBatch(const RenderBatch& batch) {
+	setBlendMode(batch.blend);
+
+	if (batch.kind == RenderKind::QUAD) {
+		level_shader.use();
+		quad_buffer.draw(batch.first * 4, batch.count * 4);
+		return;
+	}
+
+	if (batch.kind == RenderKind::ARC) {
+		arc_shader.use();
+		arc_buffer.draw(batch.first, batch.count);
+		return;
+	}
+
+	sprite_shader.use();
+	sprite_buffer.draw(batch.first, batch.count);
+}
+
+Renderer::Renderer(VertexFormat format)
+: format(format) {
 
 	Vert2f vertices_quad[] = {
 		{0, 0},
@@ -30,43 +163,122 @@ Renderer::Renderer() {
 
 	pass_1.init();
 	pass_2 = Framebuffer::main();
+	pass_crt.init();
 
-	color_att.init();
-	color_att.resize(SW, SH, GL_RGBA, GL_RGBA);
-
-	depth_att.init();
-	depth_att.resize(SW, SH, GL_DEPTH24_STENCIL8, GL_DEPTH24_STENCIL8);
-
-	color_att.use();
-	pass_1.attach(color_att, GL_COLOR_ATTACHMENT0);
-
-	depth_att.use();
-	pass_1.attach(depth_att, GL_DEPTH_STENCIL_ATTACHMENT);
+	// targets are sized for the window region, which is not known yet,
+	// the CRT target is only needed at reduced scale and is allocated on demand
+	scene_w = SW;
+	scene_h = SH;
+	attachTarget(pass_1, color_att, scene_w, scene_h, "scene target");
 
 	// Create and compile the shader program
 	level_shader.init("assets/shader/level");
+	sprite_shader.init("assets/shader/sprite.vert", "assets/shader/level.frag");
+	arc_shader.init("assets/shader/arc");
 	degrade_shader.init("assets/shader/degrade");
+	reduced_shader.init("assets/shader/degrade.vert", "assets/shader/degrade_lite.frag");
 
 	// Create buffer layout
-	geometry_layout.attribute(level_shader.attribute("iPos"), 2, GL_FLOAT);
-	geometry_layout.attribute(level_shader.attribute("iTex"), 2, GL_FLOAT);
+	if (format == VertexFormat::COMPACT) {
+		geometry_layout.attribute(level_shader.attribute("iPos"), 2, GL_SHORT);
+		geometry_layout.attribute(level_shader.attribute("iTex"), 2, GL_UNSIGNED_SHORT, true);
+	} else {
+		geometry_layout.attribute(level_shader.attribute("iPos"), 2, GL_FLOAT);
+		geometry_layout.attribute(level_shader.attribute("iTex"), 2, GL_FLOAT);
+	}
+
 	geometry_layout.attribute(level_shader.attribute("iCol"), 4, GL_UNSIGNED_BYTE, true);
+	sprite_layout.attribute(sprite_shader.attribute("iPos"), 2, GL_FLOAT);
+	sprite_layout.attribute(sprite_shader.attribute("iSize"), 2, GL_FLOAT);
+	sprite_layout.attribute(sprite_shader.attribute("iAngle"), 1, GL_FLOAT);
+	sprite_layout.attribute(sprite_shader.attribute("iSprite"), 1, GL_UNSIGNED_INT);
+	sprite_layout.attribute(sprite_shader.attribute("iCol"), 4, GL_UNSIGNED_BYTE, true);
+	sprite_layout.instanced();
+	arc_layout.attribute(arc_shader.attribute("iSpan"), 4, GL_FLOAT);
+	arc_layout.attribute(arc_shader.attribute("iWave"), 4, GL_FLOAT);
+	arc_layout.attribute(arc_shader.attribute("iSprite"), 1, GL_UNSIGNED_INT);
+	arc_layout.attribute(arc_shader.attribute("iCol"), 4, GL_UNSIGNED_BYTE, true);
+	arc_layout.instanced();
 	screen_layout.attribute(degrade_shader.attribute("iPos"), 2, GL_FLOAT);
 
+	// fixed point positions are scaled back into pixels in the shader
+	level_shader.use();
+	glUniform1f(level_shader.uniform("uUnit"), format == VertexFormat::COMPACT ? 1.0f / Vert2s2us4b::unit : 1.0f);
+
+	// sprite UVs are fetched from the atlas sprite table
+	sprite_shader.use();
+	glUniform1i(sprite_shader.uniform("uSprites"), 1);
+
+	// arcs are displaced along a noise texture, instead of evaluating noise on the CPU for every column
+	const std::vector<float> noise = getNoiseTable();
+	arc_noise.init();
+	arc_noise.setResource(GpuResource::TEXTURE, "arc noise");
+	arc_noise.upload(noise.data(), ArcInstance::period_x * noise_density, ArcInstance::period_y * noise_density, GL_R16F, GL_RED, GL_FLOAT);
+	arc_noise.setFilter(GL_LINEAR);
+
+	arc_shader.use();
+	glUniform1i(arc_shader.uniform("uSprites"), 1);
+	glUniform1i(arc_shader.uniform("uNoise"), 2);
+
+	// curvature is smooth, so a small filtered table is indistinguishable from computing it
+	const std::vector<float> curve = getCurveTable();
+	crt_lut.init();
+	crt_lut.setResource(GpuResource::TEXTURE, "crt curve");
+	crt_lut.upload(curve.data(), lut_size, lut_size, GL_RGBA16F, GL_RGBA, GL_FLOAT);
+	crt_lut.setFilter(GL_LINEAR);
+	crt_lut.setWrap(GL_CLAMP_TO_EDGE);
+
+	reduced_shader.use();
+	glUniform1i(reduced_shader.uniform("uCurve"), 1);
+
+	#if defined(GAME_HEADLESS)
+
+		// runs need to be reproducible, so the quality is fixed instead of measured on the host or read from local data
+		const char* forced = getenv("HEADLESS_CRT");
+		const std::string stored = forced ? forced : getQualityName(CrtQuality::FULL);
+
+		quality = CrtQuality::FULL;
+		calibrated = true;
+	#else
+
+		// measured once per device, the result is stored with the rest of local data
+		const std::string stored = platform_read_string(crt_quality_key);
+	#endif
+
+	for (CrtQuality option : {CrtQuality::OFF, CrtQuality::REDUCED, CrtQuality::FULL}) {
+		if (stored == getQualityName(option)) {
+			quality = option;
+			calibrated = true;
+		}
+	}
+
+	timer.init();
 	blit_buffer.init(screen_layout, GL_STATIC_DRAW);
+	blit_buffer.setLabel("blit vertices");
 	blit_buffer.upload((uint8_t*) vertices_quad, sizeof(vertices_quad));
 
-	font8x8.init("assets/font8x8.png", 8);
-	tileset.init("assets/tileset.png", 16);
+	atlas.add(font8x8, "assets/font8x8.png", 8);
+	atlas.add(tileset, "assets/tileset.png", 16);
+	atlas.pack();
 
-	game_buffer.init(geometry_layout, GL_DYNAMIC_DRAW);
-	text_buffer.init(geometry_layout, GL_DYNAMIC_DRAW);
+	// all geometry is made from quads, they share a single index buffer
+	quad_indices.init();
+	quad_buffer.init(geometry_layout, GL_DYNAMIC_DRAW, &quad_indices);
+	sprite_buffer.init(sprite_layout, GL_DYNAMIC_DRAW);
+	arc_buffer.init(arc_layout, GL_DYNAMIC_DRAW);
 
-	game_writer.init(&game_buffer);
-	text_writer.init(&text_buffer);
+	quad_buffer.setLabel("quad vertices");
+	sprite_buffer.setLabel("sprite instances");
+	arc_buffer.setLabel("arc instances");
 
-	terrain.init(&game_writer, &tileset);
-	text.init(&text_writer, &font8x8);
+	quad_writer.init(&quad_buffer);
+	sprite_writer.init(&sprite_buffer);
+	arc_writer.init(&arc_buffer);
+
+	terrain.init(&queue, &tileset, LayerOrder::TERRAIN, format);
+	hud.init(&queue, &tileset, LayerOrder::HUD, format);
+	text.init(&queue, &font8x8, LayerOrder::TEXT, format);
+	debug.init(&queue, &tileset, LayerOrder::DEBUG, format);
 
 	// enable blending
 	setBlend(true);
@@ -78,35 +290,295 @@ Renderer::Renderer() {
 	printf("Render system started!\n");
 }
 
-void Renderer::beginDraw(const std::chrono::time_point<std::chrono::steady_clock>& begin_time, float aliveness) {
-	degrade_shader.use();
-	const auto now_time = std::chrono::steady_clock::now();
-	glUniform1f(degrade_shader.uniform("uTime"), std::chrono::duration_cast<std::chrono::duration<float>>(now_time - begin_time).count());
-	glUniform1f(degrade_shader.uniform("uAliveness"), aliveness);
-	glViewport(0, 0, SW, SH);
+void Renderer::resizeTargets() {
+	const float scale = scaler.getScale();
+
+	const int sw = std::max(1, (int) std::round(SW * scale));
+	const int sh = std::max(1, (int) std::round(SH * scale));
+
+	if (sw != scene_w || sh != scene_h) {
+		scene_w = sw;
+		scene_h = sh;
+		attachTarget(pass_1, color_att, scene_w, scene_h, "scene target");
+	}
+
+	const int cw = std::max(1, (int) std::round(region_w * scale));
+	const int ch = std::max(1, (int) std::round(region_h * scale));
+
+	// at full scale the effect is drawn straight into the window, the CRT target is not used
+	if (scale >= 1.0f) {
+		crt_w = 0;
+		crt_h = 0;
+		attachTarget(pass_crt, crt_att, 0, 0, "crt target");
+	} else if (cw != crt_w || ch != crt_h) {
+		crt_w = cw;
+		crt_h = ch;
+		attachTarget(pass_crt, crt_att, crt_w, crt_h, "crt target");
+	}
+
+	const glm::mat4 target_matrix {
+		 2,  0,  0,  0,
+		 0,  2,  0,  0,
+		 0,  0,  1,  0,
+		-1, -1,  0,  1,
+	};
+
+	// at full scale the effect is drawn straight into the window
+	for (Shader* shader : {&degrade_shader, &reduced_shader}) {
+		shader->use();
+
+		if (scale < 1.0f) {
+			glUniform2f(shader->uniform("uResolution"), crt_w, crt_h);
+			glUniformMatrix4fv(shader->uniform("uMatrix"), 1, GL_FALSE, glm::value_ptr(target_matrix));
+		} else {
+			glUniform2f(shader->uniform("uResolution"), region_w, region_h);
+			glUniformMatrix4fv(shader->uniform("uMatrix"), 1, GL_FALSE, glm::value_ptr(region_matrix));
+		}
+	}
+}
+
+void Renderer::attachTarget(Framebuffer& pass, NULLABLE Texture*& target, int w, int h, const char* label) {
+	Texture* previous = target;
+	target = nullptr;
+
+	// acquire before releasing, so that the previous size stays pooled in case the scale goes back
+	if (w > 0 && h > 0) {
+		target = &targets.acquire(w, h, GL_RGBA8, GL_RGBA, label);
+		pass.attach(*target, GL_COLOR_ATTACHMENT0);
+	} else if (previous != nullptr) {
+		pass.detach(GL_COLOR_ATTACHMENT0);
+	}
+
+	if (previous != nullptr) {
+		targets.release(*previous);
+	}
 }
 
-void Renderer::endDraw(int vw, int vh) {
-	game_writer.upload();
-	text_writer.upload();
+Shader* Renderer::getCrtShader() {
+	switch (quality) {
+		case CrtQuality::OFF: return nullptr;
+		case CrtQuality::REDUCED: return &reduced_shader;
+		case CrtQuality::FULL: return &degrade_shader;
+	}
 
-	// render
+	return nullptr;
+}
+
+void Renderer::drawEffect(CrtQuality quality) {
+	const int mx = (window_w - region_w) / 2;
+	const int my = (window_h - region_h) / 2;
+
+	glViewport(0, 0, window_w, window_h);
+
+	// without the effect the scene can be copied over directly
+	if (quality == CrtQuality::OFF) {
+		pass_2.clear();
+		pass_1.blit(pass_2, 0, 0, scene_w, scene_h, mx, my, region_w, region_h);
+		return;
+	}
+
+	color_att->use(0);
+	crt_lut.use(1);
+
+	Shader& shader = (quality == CrtQuality::FULL) ? degrade_shader : reduced_shader;
+	shader.use();
+
+	if (scaler.getScale() >= 1.0f) {
+		pass_2.clear();
+		blit_buffer.draw();
+		return;
+	}
+
+	// at reduced scale the effect itself is rendered at a lower resolution and stretched over the region
+	glViewport(0, 0, crt_w, crt_h);
+	pass_crt.use();
+	blit_buffer.draw();
+
+	glViewport(0, 0, window_w, window_h);
+	pass_2.clear();
+	pass_crt.blit(pass_2, 0, 0, crt_w, crt_h, mx, my, region_w, region_h);
+}
+
+float Renderer::measureEffect(CrtQuality quality) {
+	uint8_t pixel[4];
+
+	// the first draw can include lazy shader compilation, don't count it,
+	// reading back a pixel waits until the GPU is done with all queued work
+	drawEffect(quality);
+	pass_2.use();
+	glReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+
+	// prefer the time the GPU actually spent, the readback below also counts the CPU side and the stall
+	if (timer.isSupported()) {
+		timer.beginSample();
+
+		for (int i = 0; i < calibration_runs; i ++) {
+			drawEffect(quality);
+		}
+
+		const float milliseconds = timer.endSample();
+
+		if (milliseconds >= 0) {
+			return milliseconds / 1000.0f / calibration_runs;
+		}
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < calibration_runs; i ++) {
+		drawEffect(quality);
+	}
+
+	pass_2.use();
+	glReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::duration<float>>(end - start).count() / calibration_runs;
+}
+
+void Renderer::calibrate() {
+	const float limit = scaler.getBudget() * crt_budget;
+	const float full = measureEffect(CrtQuality::FULL);
+	const float reduced = measureEffect(CrtQuality::REDUCED);
+	const float off = measureEffect(CrtQuality::OFF);
+
+	CrtQuality selected = CrtQuality::OFF;
+
+	if (full <= limit) {
+		selected = CrtQuality::FULL;
+	} else if (reduced <= limit) {
+		selected = CrtQuality::REDUCED;
+	}
+
+	printf("CRT effect took %.2fms (full), %.2fms (reduced), %.2fms (off), selected '%s'\n", full * 1000, reduced * 1000, off * 1000, getQualityName(selected));
+	setQuality(selected);
+}
+
+void Renderer::setQuality(CrtQuality quality) {
+	this->quality = quality;
+	this->calibrated = true;
+
+	#if !defined(GAME_HEADLESS)
+		platform_write_string(crt_quality_key, getQualityName(quality));
+	#endif
+}
+
+CrtQuality Renderer::getQuality() const {
+	return quality;
+}
+
+void Renderer::setViewport(int w, int h, int rw, int rh, const glm::mat4& matrix) {
+	const glm::mat4 static_matrix {
+		 2.0f/SW, 0,       0,   0,
+		 0,       2.0f/SH, 0,   0,
+		 0,       0,       1,   0,
+		-1,      -1,       0,   1,
+	};
+
+	level_shader.use();
+	glUniformMatrix4fv(level_shader.uniform("uMatrix"), 1, GL_FALSE, glm::value_ptr(static_matrix));
+
+	sprite_shader.use();
+	glUniformMatrix4fv(sprite_shader.uniform("uMatrix"), 1, GL_FALSE, glm::value_ptr(static_matrix));
+
+	arc_shader.use();
+	glUniformMatrix4fv(arc_shader.uniform("uMatrix"), 1, GL_FALSE, glm::value_ptr(static_matrix));
+
+	window_w = w;
+	window_h = h;
+	region_w = rw;
+	region_h = rh;
+	region_matrix = matrix;
+
+	resizeTargets();
+
+	// the effect can only be measured once we know how many pixels it covers
+	if (!calibrated) {
+		calibrate();
+	}
+}
+
+void Renderer::beginDraw(float time, float aliveness, Rectangle canvas) {
+	frame.time = time;
+	frame.aliveness = aliveness;
+	frame.canvas = canvas;
+	emit_start = std::chrono::steady_clock::now();
+}
+
+Rectangle Renderer::getCanvasSize() const {
+	return frame.canvas;
+}
+
+void Renderer::endDraw(DrawList& list) {
+	list.queue.swap(queue);
+	list.time = frame.time;
+	list.aliveness = frame.aliveness;
+	list.emit_ms = std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(std::chrono::steady_clock::now() - emit_start).count();
+}
+
+void Renderer::endDraw() {
+	endDraw(frame);
+	draw(frame);
+}
+
+void Renderer::draw(DrawList& list) {
+	RenderStats::getInstance().flush();
+
+	const auto now_time = std::chrono::steady_clock::now();
+
+	if (Shader* shader = getCrtShader()) {
+		shader->use();
+		glUniform1f(shader->uniform("uTime"), list.time);
+		glUniform1f(shader->uniform("uAliveness"), list.aliveness);
+	}
+
+	// without GPU timers the CPU frame time is the best load estimate we have
+	if (last_frame != std::chrono::steady_clock::time_point {}) {
+		if (scaler.update(std::chrono::duration_cast<std::chrono::duration<float>>(now_time - last_frame).count())) {
+			resizeTargets();
+		}
+	}
+
+	last_frame = now_time;
+	timer.beginFrame();
+	targets.trim();
+
+	FrameStats& stats = RenderStats::getInstance().frame();
+	stats.scale = scaler.getScale();
+	stats.timed = timer.isSupported();
+	stats.scene_ms = timer.getTime(RenderPass::SCENE);
+	stats.effect_ms = timer.getTime(RenderPass::EFFECT);
+	stats.emit_ms = list.emit_ms;
+
+	const std::vector<RenderBatch>& batches = list.queue.flush(quad_writer, sprite_writer, arc_writer);
+	stats.batches = batches.size();
+
+	quad_writer.upload();
+	sprite_writer.upload();
+	arc_writer.upload();
+
+	// render, the projection stays in game units, only the viewport follows the scale
+	timer.begin(RenderPass::SCENE);
+	glViewport(0, 0, scene_w, scene_h);
 	pass_1.use();
 	pass_1.clear();
 
-	tileset.use();
-	level_shader.use();
-	game_buffer.draw();
+	// all sheets share one texture, so only the shader and blending change between batches
+	atlas.use();
+	arc_noise.use(2);
 
-	font8x8.use();
-	text_buffer.draw();
+	for (const RenderBatch& batch : batches) {
+		drawBatch(batch);
+	}
 
-	glViewport(0, 0, vw, vh);
+	setBlendMode(BlendMode::ALPHA);
+	timer.end(RenderPass::SCENE);
 
 	// apply a CRT-like effect and draw into back buffer
-	pass_2.use();
-	pass_2.clear();
-	color_att.use();
-	degrade_shader.use();
-	blit_buffer.draw();
-}
\ No newline at end of file
+	timer.begin(RenderPass::EFFECT);
+	drawEffect(quality);
+	timer.end(RenderPass::EFFECT);
+
+	stats.submit_ms = std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(std::chrono::steady_clock::now() - now_time).count();
+	list.canvas = {window_w, window_h};
+}
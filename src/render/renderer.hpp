@@ -1,16 +1,69 @@
 #pragma once
 #include "buffer.hpp"
 #include "framebuffer.hpp"
+#include "pool.hpp"
+#include "atlas.hpp"
 #include "layout.hpp"
+#include "queue.hpp"
+#include "scaler.hpp"
+#include "timer.hpp"
 #include "shader.hpp"
 #include "vertex.hpp"
 
+/// Draw order of render layers, later layers are drawn over earlier ones
+enum struct LayerOrder : uint8_t {
+	TERRAIN = 0,
+	HUD     = 1,
+	TEXT    = 2,
+	DEBUG   = 3,
+};
+
+/// Quality of the CRT post-process effect, from cheapest to most expensive
+enum struct CrtQuality : uint8_t {
+	OFF     = 0, // scene is copied to the screen as-is
+	REDUCED = 1, // precomputed curvature and vignette, single chroma sample
+	FULL    = 2,
+};
+
+/// Submits geometry into the render queue under a single layer
 struct RenderLayer {
 
-	BufferWriter<Vert4f4b>* writer;
+	RenderQueue* queue;
 	TileSet* tileset;
+	LayerOrder order;
+	VertexFormat format;
+	BlendMode blend;
+
+	void init(RenderQueue* queue, TileSet* tileset, LayerOrder order, VertexFormat format, BlendMode blend = BlendMode::ALPHA);
+
+	/// Submit a quad, the vertices need to be in the order of the quad index pattern, they are packed into the layer format right away
+	void quad(const Vert4f4b& a, const Vert4f4b& b, const Vert4f4b& c, const Vert4f4b& d, uint16_t depth = 0);
+
+	/// Submit a batch of quads, 4 vertices each
+	void quads(const Vert4f4b* vertices, size_t count, uint16_t depth = 0);
+
+	/// Submit a sprite instance
+	void sprite(const SpriteInstance& instance, uint16_t depth = 0);
+
+	/// Submit a batch of sprite instances
+	void sprites(const std::vector<SpriteInstance>& batch, uint16_t depth = 0);
 
-	void init(BufferWriter<Vert4f4b>* writer, TileSet* tileset);
+	/// Submit an electric arc instance
+	void arc(const ArcInstance& instance, uint16_t depth = 0);
+
+};
+
+/// Everything needed to render a single frame, can be handed over to the thread that owns the GL context
+struct DrawList {
+
+	RenderQueue queue;
+	float time = 0;
+	float aliveness = 0;
+	float emit_ms = 0;
+
+	// size of the canvas, updated whenever the list is drawn, so that the thread
+	// emitting into it next never has to read the window state
+	Rectangle canvas {0, 0};
 
 };
 
@@ -18,38 +71,120 @@ class Renderer {
 
 	private:
 
+		VertexFormat format;
+
 		Framebuffer pass_1;
 		Framebuffer pass_2;
+		Framebuffer pass_crt;
+
+		// the scene is flat and drawn in order, so the passes need no depth or stencil attachments
+		TargetPool targets;
+		NULLABLE Texture* color_att = nullptr;
+		NULLABLE Texture* crt_att = nullptr;
+		Texture crt_lut;
+		Texture arc_noise;
+
+		CrtQuality quality = CrtQuality::FULL;
+		bool calibrated = false;
+
+		// window size, and the letterboxed region the game is displayed in
+		int window_w = 0, window_h = 0;
+		int region_w = 0, region_h = 0;
+		glm::mat4 region_matrix {1.0f};
 
-		Texture color_att;
-		RenderBuffer depth_att;
+		// resolution the scene and the CRT effect are currently rendered at
+		int scene_w = 0, scene_h = 0;
+		int crt_w = 0, crt_h = 0;
+
+		std::chrono::steady_clock::time_point last_frame {};
+		std::chrono::steady_clock::time_point emit_start {};
+
+		// frame being emitted, also used as the draw list when everything runs on one thread
+		DrawList frame;
+		GpuTimer timer;
 
 		Layout geometry_layout;
+		Layout sprite_layout;
 		Layout screen_layout;
+		Layout arc_layout;
 
+		QuadIndexBuffer quad_indices;
 		VertexBuffer blit_buffer;
-		VertexBuffer game_buffer;
-		VertexBuffer text_buffer;
+		VertexBuffer quad_buffer;
+		InstanceBuffer sprite_buffer;
+		InstanceBuffer arc_buffer;
+
+		BufferWriter<uint8_t> quad_writer;
+		BufferWriter<SpriteInstance> sprite_writer;
+		BufferWriter<ArcInstance> arc_writer;
 
-		BufferWriter<Vert4f4b> game_writer;
-		BufferWriter<Vert4f4b> text_writer;
+		RenderQueue queue;
 
+		Atlas atlas;
 		TileSet font8x8;
 		TileSet tileset;
 
+		/// Resize the offscreen targets to match the current resolution scale
+		void resizeTargets();
+
+		/// Replace the color attachment of the pass with a pooled target of given size, or just free it if the size is zero
+		void attachTarget(Framebuffer& pass, NULLABLE Texture*& target, int w, int h, const char* label);
+
+		/// Get the shader for the selected CRT quality, null if the effect is off
+		NULLABLE Shader* getCrtShader();
+
+		/// Draw the scene into the back buffer with the given quality of the CRT effect
+		void drawEffect(CrtQuality quality);
+
+		/// Get the average time the GPU takes to draw the CRT effect of given quality, in seconds
+		float measureEffect(CrtQuality quality);
+
+		/// Pick the best CRT quality that fits into the frame budget
+		void calibrate();
+
+		/// Draw a single batch of sorted queue items, the atlas needs to be bound
+		void drawBatch(const RenderBatch& batch);
+
 	public:
 
 		Shader level_shader;
+		Shader sprite_shader;
+		Shader arc_shader;
 		Shader degrade_shader;
+		Shader reduced_shader;
+
+		ResolutionScaler scaler;
 
 		RenderLayer terrain;
+		RenderLayer hud;
 		RenderLayer text;
+		RenderLayer debug;
 
 	public:
 
-		Renderer();
+		explicit Renderer(VertexFormat format = VertexFormat::COMPACT);
+
+		/// Select the CRT quality, the choice is remembered between runs
+		void setQuality(CrtQuality quality);
+
+		CrtQuality getQuality() const;
+
+		/// Update the window size, rw and rh is the size of the region the game is displayed in
+		void setViewport(int w, int h, int rw, int rh, const glm::mat4& matrix);
+
+		/// Start emitting a frame, time is in seconds since the start of the game, it drives the CRT effect animation
+		void beginDraw(float time, float aliveness, Rectangle canvas);
+
+		/// Get the size of the canvas the frame being emitted is for
+		Rectangle getCanvasSize() const;
+
+		/// Finish emitting the frame and move it into the given draw list, does not touch the GL context
+		void endDraw(DrawList& list);
+
+		/// Finish emitting the frame and draw it right away
+		void endDraw();
 
-		void beginDraw(const std::chrono::time_point<std::chrono::steady_clock>& begin_time, float aliveness);
-		void endDraw(int vw, int vh);
+		/// Render a draw list, needs to be called on the thread that owns the GL context
+		void draw(DrawList& list);
 
 };
@@ -0,0 +1,82 @@
+
+#include "report.hpp"
+
+/*
+ * FrameReport
+ */
+
+/// Get the value below which the given fraction of samples fall
+static float getPercentile(std::vector<float> samples, float fraction) {
+	if (samples.empty()) {
+		return 0;
+	}
+
+	const size_t index = std::min(samples.size() - 1, (size_t) (samples.size() * fraction));
+	std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+	return samples[index];
+}
+
+FrameReport::FrameReport(const std::string& path)
+: output(path) {
+	if (!output.is_open()) {
+		fault("Unable to open frame report: '%s'!\n", path.c_str());
+	}
+
+	output << "frame,emit_ms,submit_ms,scene_ms,effect_ms,uploaded,grows,skipped,batches,draws,scale,texture_bytes,target_bytes,buffer_bytes\n";
+}
+
+void FrameReport::record(const FrameStats& stats) {
+	output << frames.size() << ','
+		<< stats.emit_ms << ','
+		<< stats.submit_ms << ','
+		<< (stats.timed ? stats.scene_ms : -1) << ','
+		<< (stats.timed ? stats.effect_ms : -1) << ','
+		<< stats.uploaded << ','
+		<< stats.grows << ','
+		<< stats.skipped << ','
+		<< stats.batches << ','
+		<< stats.draws << ','
+		<< stats.scale << ','
+		<< stats.getMemory(GpuResource::TEXTURE) << ','
+		<< stats.getMemory(GpuResource::TARGET) << ','
+		<< stats.getMemory(GpuResource::BUFFER) << '\n';
+
+	frames.push_back(stats);
+}
+
+void FrameReport::summary() const {
+	if (frames.empty()) {
+		printf("No frames were recorded!\n");
+		return;
+	}
+
+	std::vector<float> emit, submit;
+	double uploaded = 0, draws = 0;
+	FrameStats peak;
+
+	for (const FrameStats& stats : frames) {
+		emit.push_back(stats.emit_ms);
+		submit.push_back(stats.submit_ms);
+		uploaded += stats.uploaded;
+		draws += stats.draws;
+
+		for (size_t i = 0; i < peak.memory.size(); i ++) {
+			peak.memory[i] = std::max(peak.memory[i], stats.memory[i]);
+		}
+	}
+
+	const auto mib = [&] (GpuResource resource) {
+		return peak.getMemory(resource) / (1024.0 * 1024.0);
+	};
+
+	printf("Rendered %d frames\n", (int) frames.size());
+	printf("Emit:   median %.3fms, p95 %.3fms, max %.3fms\n", getPercentile(emit, 0.5f), getPercentile(emit, 0.95f), getPercentile(emit, 1.0f));
+	printf("Submit: median %.3fms, p95 %.3fms, max %.3fms\n", getPercentile(submit, 0.5f), getPercentile(submit, 0.95f), getPercentile(submit, 1.0f));
+	printf("Upload: %.1fK per frame, %.1f draws per frame\n", uploaded / frames.size() / 1024, draws / frames.size());
+	printf("Memory: peak %.2fM textures, %.2fM targets, %.2fM buffers\n", mib(GpuResource::TEXTURE), mib(GpuResource::TARGET), mib(GpuResource::BUFFER));
+
+	// peaks of single resources need not happen at the same time, so they don't have to add up to the totals
+	for (const auto& [label, memory] : RenderStats::getInstance().getResources()) {
+		printf("        %-16s peak %.2fM, now %.2fM\n", label.c_str(), memory.peak / (1024.0 * 1024.0), memory.bytes / (1024.0 * 1024.0));
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <external.hpp>
+#include "stats.hpp"
+
+/// Writes render statistics of every frame into a CSV file, used by headless benchmark runs
+class FrameReport {
+
+	private:
+
+		std::ofstream output;
+		std::vector<FrameStats> frames;
+
+	public:
+
+		explicit FrameReport(const std::string& path);
+
+		/// Add the counters of a fully rendered frame
+		void record(const FrameStats& stats);
+
+		/// Print averages and percentiles of all recorded frames
+		void summary() const;
+
+};
@@ -0,0 +1,77 @@
+
+#include "scaler.hpp"
+
+/*
+ * ResolutionScaler
+ */
+
+// frames that have to agree before the scale is changed
+static constexpr int frames_down = 30;
+static constexpr int frames_up = 240;
+static constexpr int frames_up_limit = frames_up * 8;
+
+// how far over or under the budget the average needs to be
+static constexpr float threshold_down = 1.2f;
+static constexpr float threshold_up = 1.05f;
+
+static float quantize(float scale) {
+	return std::round(scale / ResolutionScaler::step) * ResolutionScaler::step;
+}
+
+ResolutionScaler::ResolutionScaler(float min, float max, float budget)
+: min(quantize(min)), max(quantize(max)), budget(budget), scale(quantize(max)), average(budget), patience(frames_up), since_up(frames_up_limit) {}
+
+void ResolutionScaler::setBounds(float min, float max) {
+	this->min = quantize(min);
+	this->max = quantize(max);
+	this->scale = std::clamp(scale, this->min, this->max);
+}
+
+void ResolutionScaler::setBudget(float budget) {
+	this->budget = budget;
+}
+
+float ResolutionScaler::getBudget() const {
+	return budget;
+}
+
+bool ResolutionScaler::update(float frame) {
+	average = average * 0.9f + frame * 0.1f;
+	since_up ++;
+
+	if (average > budget * threshold_down) {
+		under = 0;
+		over ++;
+	} else if (average < budget * threshold_up) {
+		over = 0;
+		under ++;
+	} else {
+		over = 0;
+		under = 0;
+	}
+
+	if (over >= frames_down && scale > min) {
+
+		// we went up only recently and it didn't work out, wait longer before trying again
+		if (since_up < frames_down * 2) {
+			patience = std::min(patience * 2, frames_up_limit);
+		}
+
+		scale = std::max(min, scale - step);
+		over = 0;
+		return true;
+	}
+
+	if (under >= patience && scale < max) {
+		scale = std::min(max, scale + step);
+		under = 0;
+		since_up = 0;
+		return true;
+	}
+
+	return false;
+}
+
+float ResolutionScaler::getScale() const {
+	return scale;
+}
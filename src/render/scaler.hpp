@@ -0,0 +1,50 @@
+#pragma once
+
+#include <external.hpp>
+
+/// Picks the render resolution scale from frame times, with hysteresis so that it doesn't oscillate
+class ResolutionScaler {
+
+	public:
+
+		/// Scale only ever changes by whole steps, so that render targets are not reallocated every frame
+		static constexpr float step = 0.125f;
+
+	private:
+
+		float min, max;
+		float budget;
+		float scale;
+
+		// exponential moving average of the frame time
+		float average;
+
+		// consecutive frames spent over or under budget
+		int over = 0;
+		int under = 0;
+
+		// frames under budget needed before trying to scale up, grows after every failed attempt
+		int patience;
+		int since_up;
+
+	public:
+
+		/// Budget is the target frame time in seconds
+		ResolutionScaler(float min = 0.5f, float max = 1.0f, float budget = 1.0f / 60.0f);
+
+		/// Change the allowed scale range, the current scale is clamped into it
+		void setBounds(float min, float max);
+
+		/// Change the target frame time in seconds
+		void setBudget(float budget);
+
+		/// Get the target frame time in seconds
+		float getBudget() const;
+
+		/// Feed the duration of the last frame in seconds, returns true if the scale changed
+		bool update(float frame);
+
+		/// Get the current scale, always a multiple of step
+		float getScale() const;
+
+};
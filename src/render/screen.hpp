@@ -3,6 +3,7 @@
 #include <external.hpp>
 #include <rendering.hpp>
 #include <util/field.hpp>
+#include <render/renderer.hpp>
 #include <const.hpp>
 
 struct ScreenTile {
@@ -69,6 +70,55 @@ class Screen {
 		uint32_t render_start = 0;
 		uint32_t render_end = 0;
 
+		// quads of all rows, the open and close animations only change which rows are emitted
+		std::vector<Vert4f4b> mesh;
+		std::vector<uint32_t> rows;
+		bool dirty = true;
+
+		// state the mesh was built for
+		NULLABLE const TileSet* mesh_tileset = nullptr;
+		uint16_t mesh_selected = 0;
+		int mesh_w = 0;
+		int mesh_h = 0;
+
+		void rebuild(const TileSet& tileset, int w, int h) {
+			float ox = (w - tiles.width * 32) * 0.5f;
+			float oy = (h - tiles.height * 32) * 0.5f;
+
+			mesh.clear();
+			rows.clear();
+
+			for (int y = 0; y < height; y ++) {
+				rows.push_back(mesh.size());
+
+				for (int x = 0; x < width; x ++) {
+					ScreenTile& tile = tiles.at(x, y);
+					const uint16_t color = transform(tile.color, tile.action);
+
+					if (tile.index != 0 && pallet.has(color)) {
+						const Sprite& s = tileset.sprite(tile.index);
+						ScreenColor c = pallet.get(color);
+
+						float tx = ox + x * 32.0f;
+						float ty = oy + y * 32.0f;
+
+						mesh.push_back({tx + 0,   0 + ty, s.min_u, s.min_v, c.fr, c.fg, c.fb, c.fa});
+						mesh.push_back({tx + 32,  0 + ty, s.max_u, s.min_v, c.fr, c.fg, c.fb, c.fa});
+						mesh.push_back({tx + 32, 32 + ty, s.max_u, s.max_v, c.fr, c.fg, c.fb, c.fa});
+						mesh.push_back({tx + 0,  32 + ty, s.min_u, s.max_v, c.fr, c.fg, c.fb, c.fa});
+					}
+				}
+			}
+
+			rows.push_back(mesh.size());
+
+			mesh_tileset = &tileset;
+			mesh_selected = selected;
+			mesh_w = w;
+			mesh_h = h;
+			dirty = false;
+		}
+
 	protected:
 
 		Field<ScreenTile> tiles;
@@ -85,11 +135,9 @@ class Screen {
 
 		virtual ~Screen() {}
 
-		void render(TileSet& tileset, BufferWriter<Vert4f4b>& buffer) {
-			const auto [w, h] = getCanvasSize();
-
-			float ox = (w - tiles.width * 32) * 0.5f;
-			float oy = (h - tiles.height * 32) * 0.5f;
+		void render(RenderLayer& layer, Rectangle canvas) {
+			const TileSet& tileset = *layer.tileset;
+			const auto [w, h] = canvas;
 
 			if (state == ScreenState::OPENING) {
 				if (render_start > 0) {
@@ -109,27 +157,18 @@ class Screen {
 				}
 			}
 
-			for (int y = render_start; y < render_end; y ++) {
-				for (int x = 0; x < width; x ++) {
-					ScreenTile& tile = tiles.at(x, y);
-					const uint16_t color = transform(tile.color, tile.action);
-
-					if (tile.index != 0 && pallet.has(color)) {
-						Sprite s = tileset.sprite(tile.index);
-						ScreenColor c = pallet.get(color);
+			if (dirty || mesh_tileset != &tileset || mesh_selected != selected || mesh_w != w || mesh_h != h) {
+				rebuild(tileset, w, h);
+			}
 
-						float tx = ox + x * 32.0f;
-						float ty = oy + y * 32.0f;
+			// rows are stored in order, so the visible ones form a single range
+			const uint32_t first = rows[render_start];
+			layer.quads(mesh.data() + first, (rows[render_end] - first) / 4);
+		}
 
-						buffer.push({tx + 0,   0 + ty, s.min_u, s.min_v, c.fr, c.fg, c.fb, c.fa});
-						buffer.push({tx + 32,  0 + ty, s.max_u, s.min_v, c.fr, c.fg, c.fb, c.fa});
-						buffer.push({tx + 32, 32 + ty, s.max_u, s.max_v, c.fr, c.fg, c.fb, c.fa});
-						buffer.push({tx + 32, 32 + ty, s.max_u, s.max_v, c.fr, c.fg, c.fb, c.fa});
-						buffer.push({tx + 0,  32 + ty, s.min_u, s.max_v, c.fr, c.fg, c.fb, c.fa});
-						buffer.push({tx + 0,   0 + ty, s.min_u, s.min_v, c.fr, c.fg, c.fb, c.fa});
-					}
-				}
-			}
+		/// mark the mesh as outdated, needs to be called after the tiles change
+		void invalidate() {
+			dirty = true;
 		}
 
 		/// used for building the tilemap
@@ -217,6 +256,8 @@ class Screen {
 
 		/// build a border with a title around the interface
 		void build_frame(const char* name) {
+			invalidate();
+
 			for (int x = 0; x < width; x ++) {
 				for (int y = 0; y < height; y ++) {
 					tiles.at(x, y) = {' ', 0, 0};
@@ -252,6 +293,7 @@ class Screen {
 
 		/// build a string at the given position
 		void build_string(int x, int y, int max, const char* str, uint16_t action) {
+			invalidate();
 			int len = std::min((int) strlen(str), max);
 
 			for (int i = 0; i < len; i ++) {
@@ -272,15 +314,16 @@ class ScreenStack {
 		void open(std::shared_ptr<Screen> screen) {
 			screens.push_back(screen);
 			screen->build();
+			screen->invalidate();
 		}
 
 		inline std::shared_ptr<Screen> top() {
 			return screens.back();
 		}
 
-		void render(TileSet& tileset, BufferWriter<Vert4f4b>& buffer) {
+		void render(RenderLayer& layer, Rectangle canvas) {
 			if (!screens.empty()) {
-				top()->render(tileset, buffer);
+				top()->render(layer, canvas);
 			}
 
 			screens.remove_if([] (const std::shared_ptr<Screen>& screen) {
@@ -1,28 +1,183 @@
 
 #include "shader.hpp"
+#include "embedded.hpp"
+#include "state.hpp"
 
 /*
  * Shader
  */
 
+/// Hash used to tell apart cached program binaries
+static uint64_t getHash(std::string_view data, uint64_t hash = 0xcbf29ce484222325) {
+	for (char byte : data) {
+		hash = (hash ^ (uint8_t) byte) * 0x100000001b3;
+	}
+
+	return hash;
+}
+
+/// Name of the cache entry of a program, binaries are only valid for the same driver and sources
+static std::string getCacheKey(const std::string& vertex, const std::string& fragment) {
+	uint64_t hash = getHash(vertex);
+	hash = getHash(fragment, hash);
+
+	for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+		const char* string = (const char*) glGetString(name);
+		hash = getHash(string ? string : "", hash);
+	}
+
+	char key[32];
+	snprintf(key, sizeof(key), "%016" PRIx64, hash);
+	return key;
+}
+
+/// Program binaries need GL 4.1 or ARB_get_program_binary, and a driver that supports at least one binary format
+static bool isBinaryCacheSupported() {
+	if (!platform_has_program_binary()) {
+		return false;
+	}
+
+	GLint formats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+	return formats > 0;
+}
+
 void Shader::init(const std::string& base_path) {
-	std::string vertex_source = readFile(base_path + ".vert");
-	std::string fragment_source = readFile(base_path + ".frag");
+	init(base_path + ".vert", base_path + ".frag");
+}
 
-	GLuint vert = compileShaderSource(GL_VERTEX_SHADER, vertex_source.c_str());
-	GLuint frag = compileShaderSource(GL_FRAGMENT_SHADER, fragment_source.c_str());
-	this->program = linkShaderProgram(vert, frag);
+void Shader::init(const std::string& vertex_path, const std::string& fragment_path) {
+	std::string vertex_source = readSource(vertex_path);
+	std::string fragment_source = readSource(fragment_path);
+	std::string key = getCacheKey(vertex_source, fragment_source);
 
-	glDeleteShader(vert);
-	glDeleteShader(frag);
+	// without the entry points the binary functions are null, so the cache is skipped entirely
+	const bool cached = isBinaryCacheSupported();
+	this->program = cached ? loadProgramBinary(key) : 0;
+
+	if (program == 0) {
+		GLuint vert = compileShaderSource(GL_VERTEX_SHADER, vertex_source.c_str());
+		GLuint frag = compileShaderSource(GL_FRAGMENT_SHADER, fragment_source.c_str());
+		this->program = linkShaderProgram(vert, frag, cached);
+
+		glDeleteShader(vert);
+		glDeleteShader(frag);
+
+		if (cached) {
+			saveProgramBinary(key, program);
+		}
+	}
+
+	resolveUniforms();
+}
+
+std::string Shader::readSource(const std::string& path) {
+	std::string_view embedded = getEmbeddedFile(path);
+
+	if (!embedded.empty()) {
+		return std::string {embedded};
+	}
+
+	return readFile(path);
+}
+
+GLuint Shader::loadProgramBinary(const std::string& key) {
+
+	// WebGL has no program binaries, browsers do their own caching
+	#if !defined(__EMSCRIPTEN__)
+		std::ifstream file {"./local/shaders/" + key, std::ios::binary};
+
+		if (!file) {
+			return 0;
+		}
+
+		GLenum format = 0;
+		file.read((char*) &format, sizeof(format));
+		std::string binary {std::istreambuf_iterator<char> {file}, {}};
+
+		GLuint program = glCreateProgram();
+		glProgramBinary(program, format, binary.data(), binary.size());
+
+		GLint linked = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &linked);
+
+		// drivers are free to reject binaries at any time, for example after an update
+		if (linked == GL_FALSE) {
+			printf("Cached shader program '%s' was rejected, recompiling\n", key.c_str());
+			glDeleteProgram(program);
+			std::filesystem::remove("./local/shaders/" + key);
+			return 0;
+		}
+
+		return program;
+	#else
+		return 0;
+	#endif
+}
+
+void Shader::saveProgramBinary(const std::string& key, GLuint program) {
+	#if !defined(__EMSCRIPTEN__)
+		GLint length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+		if (length == 0) {
+			return;
+		}
+
+		GLenum format = 0;
+		std::vector<char> binary (length);
+		glGetProgramBinary(program, length, &length, &format, binary.data());
+
+		std::error_code error;
+		std::filesystem::create_directories("./local/shaders", error);
+
+		if (std::ofstream file {"./local/shaders/" + key, std::ios::binary}; file) {
+			file.write((const char*) &format, sizeof(format));
+			file.write(binary.data(), length);
+		}
+	#endif
 }
 
 void Shader::close() {
 	glDeleteProgram(program);
+	invalidateBindings();
 }
 
-int Shader::uniform(const char* name) {
-	return glGetUniformLocation(program, name);
+void Shader::resolveUniforms() {
+	GLint count = 0;
+	GLint length = 0;
+
+	glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+	glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &length);
+
+	std::vector<char> buffer (length);
+	uniforms.clear();
+
+	for (int i = 0; i < count; i ++) {
+		GLsizei written = 0;
+		GLint size = 0;
+		GLenum type = 0;
+
+		glGetActiveUniform(program, i, length, &written, &size, &type, buffer.data());
+		std::string name {buffer.data(), (size_t) written};
+
+		// arrays are reported by their first element, but are looked up by plain name
+		if (name.ends_with("[0]")) {
+			name.resize(name.size() - 3);
+		}
+
+		uniforms.push_back({name, glGetUniformLocation(program, buffer.data())});
+	}
+}
+
+int Shader::uniform(const char* name) const {
+	for (const Uniform& uniform : uniforms) {
+		if (uniform.name == name) {
+			return uniform.location;
+		}
+	}
+
+	return -1;
 }
 
 int Shader::attribute(const char* name) {
@@ -30,7 +185,7 @@ int Shader::attribute(const char* name) {
 }
 
 void Shader::use() {
-	glUseProgram(program);
+	bindProgram(program);
 }
 
 GLuint Shader::compileShaderSource(GLenum type, const char* source) {
@@ -57,12 +212,20 @@ GLuint Shader::compileShaderSource(GLenum type, const char* source) {
 	return shader;
 }
 
-GLuint Shader::linkShaderProgram(GLuint vertex, GLuint fragment) {
+GLuint Shader::linkShaderProgram(GLuint vertex, GLuint fragment, bool retrievable) {
 
 	// create shader program
 	GLuint program = glCreateProgram();
 	glAttachShader(program, vertex);
 	glAttachShader(program, fragment);
+
+	// let the driver know we will ask for the binary, some only keep it around when asked
+	#if !defined(__EMSCRIPTEN__)
+		if (retrievable) {
+			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		}
+	#endif
+
 	glLinkProgram(program);
 
 	// error checking
@@ -7,17 +7,38 @@ class Shader {
 
 	private:
 
+		struct Uniform {
+			std::string name;
+			int location;
+		};
+
 		GLuint program = 0;
 
+		// all active uniforms, resolved once after linking
+		std::vector<Uniform> uniforms;
+
+		/// Query locations of all active uniforms
+		void resolveUniforms();
+
+		/// Read shader source, embedded sources are preferred over files
+		static std::string readSource(const std::string& path);
+
+		/// Try to load a previously linked program from the binary cache, returns 0 on failure, the cache needs to be supported
+		static GLuint loadProgramBinary(const std::string& key);
+
+		/// Store the linked program in the binary cache, the cache needs to be supported
+		static void saveProgramBinary(const std::string& key, GLuint program);
+
 	public:
 
 		Shader() = default;
 
 		void init(const std::string& base_path);
+		void init(const std::string& vertex_path, const std::string& fragment_path);
 		void close();
 
-		/// Get uniform location by name
-		int uniform(const char* name);
+		/// Get uniform location by name, -1 if there is no such active uniform
+		int uniform(const char* name) const;
 
 		/// Get attribute location by name
 		int attribute(const char* name);
@@ -30,8 +51,8 @@ class Shader {
 		/// Compile shader from GLSL string
 		static GLuint compileShaderSource(GLenum type, const char* source);
 
-		/// Link shader program from two shader modules
-		static GLuint linkShaderProgram(GLuint vertex, GLuint fragment);
+		/// Link shader program from two shader modules, retrievable programs can be stored in the binary cache
+		static GLuint linkShaderProgram(GLuint vertex, GLuint fragment, bool retrievable = false);
 
 };
 
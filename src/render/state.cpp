@@ -1,5 +1,32 @@
 
 #include "state.hpp"
+#include "stats.hpp"
+
+// marks a binding as unknown, so that the next bind always goes through
+static constexpr GLuint unbound = std::numeric_limits<GLuint>::max();
+
+// on WebGL every call crosses into JavaScript, so remember what was bound
+// last and skip setting the same thing again, starts out as the default GL state
+static struct {
+	GLuint program;
+	GLuint framebuffer;
+	GLuint vertex_array;
+	GLuint array_buffer;
+	GLuint active_unit;
+	GLuint blend_mode;
+	std::array<GLuint, 8> textures;
+} bindings;
+
+static bool isBound(GLuint& binding, GLuint value) {
+	if (binding == value) {
+		RenderStats::getInstance().frame().skipped ++;
+		return true;
+	}
+
+	binding = value;
+	return false;
+}
+
 
 void setViewportArea(int w, int h) {
 	glViewport(0, 0, w, h);
@@ -21,7 +48,74 @@ void setBlend(bool enable) {
 	if (enable) {
 		glEnable(GL_BLEND);
 		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		bindings.blend_mode = (GLuint) BlendMode::ALPHA;
 	} else {
 		glDisable(GL_BLEND);
 	}
 }
+
+void setBlendMode(BlendMode mode) {
+	if (isBound(bindings.blend_mode, (GLuint) mode)) {
+		return;
+	}
+
+	if (mode == BlendMode::ADDITIVE) {
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+	} else {
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+}
+
+void bindProgram(GLuint program) {
+	if (!isBound(bindings.program, program)) {
+		glUseProgram(program);
+	}
+}
+
+void bindTexture(uint32_t unit, GLuint texture) {
+
+	// texture calls that follow act on the active unit, so it needs to be set even if the texture is already bound
+	if (!isBound(bindings.active_unit, unit)) {
+		glActiveTexture(GL_TEXTURE0 + unit);
+	}
+
+	if (unit >= bindings.textures.size() || !isBound(bindings.textures[unit], texture)) {
+		glBindTexture(GL_TEXTURE_2D, texture);
+	}
+}
+
+void bindFramebuffer(GLuint framebuffer) {
+	if (!isBound(bindings.framebuffer, framebuffer)) {
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	}
+}
+
+void bindFramebuffers(GLuint read, GLuint draw) {
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, read);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, draw);
+
+	// the cache only tracks framebuffers bound to both targets at once
+	bindings.framebuffer = (read == draw) ? read : unbound;
+}
+
+void bindVertexArray(GLuint vao) {
+	if (!isBound(bindings.vertex_array, vao)) {
+		glBindVertexArray(vao);
+	}
+}
+
+void bindArrayBuffer(GLuint vbo) {
+	if (!isBound(bindings.array_buffer, vbo)) {
+		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	}
+}
+
+void invalidateBindings() {
+	bindings.program = unbound;
+	bindings.framebuffer = unbound;
+	bindings.vertex_array = unbound;
+	bindings.array_buffer = unbound;
+	bindings.active_unit = unbound;
+	bindings.blend_mode = unbound;
+	bindings.textures.fill(unbound);
+}
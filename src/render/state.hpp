@@ -6,3 +6,32 @@ void setViewportArea(int w, int h);
 void setScissorArea(int x, int y, int w, int h);
 void setScissor(bool enable);
 void setBlend(bool enable);
+
+enum struct BlendMode : uint8_t {
+	ALPHA    = 0,
+	ADDITIVE = 1,
+};
+
+/// Select the blending function, unless it is already selected, blending needs to be enabled
+void setBlendMode(BlendMode mode);
+
+/// Bind shader program, unless it is already bound
+void bindProgram(GLuint program);
+
+/// Bind 2D texture to the given texture unit, unless it is already bound
+void bindTexture(uint32_t unit, GLuint texture);
+
+/// Bind framebuffer, unless it is already bound
+void bindFramebuffer(GLuint framebuffer);
+
+/// Bind separate read and draw framebuffers, used for blitting between them
+void bindFramebuffers(GLuint read, GLuint draw);
+
+/// Bind vertex array, unless it is already bound
+void bindVertexArray(GLuint vao);
+
+/// Bind array buffer, unless it is already bound
+void bindArrayBuffer(GLuint vbo);
+
+/// Forget all cached bindings, needs to be called after deleting any bound object
+void invalidateBindings();
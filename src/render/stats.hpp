@@ -0,0 +1,149 @@
+#pragma once
+
+#include <external.hpp>
+
+/// Kinds of GPU allocations tracked for the memory budget
+enum struct GpuResource : uint8_t {
+	TEXTURE = 0, // sprite atlas and lookup tables
+	TARGET  = 1, // offscreen render targets
+	BUFFER  = 2, // vertex and index buffers
+	COUNT   = 3,
+};
+
+/// Counters collected by the render system over a single frame
+struct FrameStats {
+
+	uint64_t uploaded = 0; // bytes written into vertex buffers
+	uint32_t grows = 0;    // vertex buffer storage reallocations
+	uint32_t skipped = 0;  // redundant binds elided by the state cache
+	uint32_t batches = 0;  // render queue batches
+	uint32_t draws = 0;    // draw calls issued
+	float scale = 1.0f;    // resolution scale the frame was rendered at
+	float emit_ms = 0;     // CPU time spent submitting geometry into the render queue
+	float submit_ms = 0;   // CPU time spent sorting, uploading and issuing draw calls
+
+	// GPU time of render passes in milliseconds, measured a few frames earlier, only set if timed is true
+	bool timed = false;
+	float scene_ms = 0;
+	float effect_ms = 0;
+
+	// bytes of GPU memory held at the end of the frame, indexed by GpuResource
+	std::array<uint64_t, (size_t) GpuResource::COUNT> memory {};
+
+	/// Get the bytes held by the given kind of resource
+	uint64_t getMemory(GpuResource resource) const {
+		return memory[(size_t) resource];
+	}
+
+	/// Get the bytes held by all tracked resources
+	uint64_t getTotalMemory() const {
+		return std::accumulate(memory.begin(), memory.end(), (uint64_t) 0);
+	}
+
+};
+
+/// GPU memory held by all resources sharing a single label
+struct ResourceMemory {
+
+	GpuResource resource;
+	uint64_t bytes = 0; // held right now
+	uint64_t peak = 0;  // most ever held at once
+
+};
+
+class RenderStats {
+
+	private:
+
+		FrameStats current;
+		FrameStats previous;
+
+		// allocations outlive frames, so they are tracked separately and copied into each frame
+		std::array<uint64_t, (size_t) GpuResource::COUNT> memory {};
+
+		// the same allocations, broken down by the label of the resource
+		std::map<std::string, ResourceMemory> resources;
+
+		// the previous frame can be read from another thread than the one rendering
+		mutable std::mutex mutex;
+
+		RenderStats() = default;
+
+	public:
+
+		static RenderStats& getInstance() {
+			static RenderStats stats;
+			return stats;
+		}
+
+		/// Counters of the frame that is being rendered right now
+		FrameStats& frame() {
+			return current;
+		}
+
+		/// Counters of the last fully rendered frame, safe to call from any thread
+		FrameStats last() const {
+			std::lock_guard lock {mutex};
+			return previous;
+		}
+
+		/// Record a change in the GPU memory held by the given kind of resource, in bytes
+		void allocate(GpuResource resource, const char* label, int64_t bytes) {
+			std::lock_guard lock {mutex};
+			memory[(size_t) resource] += bytes;
+
+			ResourceMemory& entry = resources.try_emplace(label, resource).first->second;
+			entry.bytes += bytes;
+			entry.peak = std::max(entry.peak, entry.bytes);
+		}
+
+		/// GPU memory held by each labeled resource, safe to call from any thread
+		std::map<std::string, ResourceMemory> getResources() const {
+			std::lock_guard lock {mutex};
+			return resources;
+		}
+
+		/// Finish the current frame and start collecting the next one
+		void flush() {
+			std::lock_guard lock {mutex};
+			current.memory = memory;
+			previous = current;
+			current = {};
+		}
+
+};
+
+/// GPU storage held by a single resource, reported to the render stats under its label
+class GpuAllocation {
+
+	private:
+
+		GpuResource resource;
+		const char* label;
+		size_t bytes = 0;
+
+	public:
+
+		GpuAllocation(GpuResource resource, const char* label)
+		: resource(resource), label(label) {}
+
+		/// Record that the storage was reallocated to the given size, zero once freed
+		void resize(size_t size) {
+			RenderStats::getInstance().allocate(resource, label, (int64_t) size - (int64_t) bytes);
+			bytes = size;
+		}
+
+		/// Change the kind and label the storage is reported under
+		void relabel(GpuResource resource, const char* label) {
+			RenderStats::getInstance().allocate(this->resource, this->label, - (int64_t) bytes);
+			RenderStats::getInstance().allocate(resource, label, bytes);
+			this->resource = resource;
+			this->label = label;
+		}
+
+		/// Get the size of the storage in bytes
+		size_t size() const {
+			return bytes;
+		}
+
+};
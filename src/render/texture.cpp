@@ -1,10 +1,33 @@
 
 #include "texture.hpp"
+#include "atlas.hpp"
+#include "state.hpp"
+
+/// Get the number of bytes a single pixel of the given internal format takes up
+static size_t getPixelSize(GLenum internal_format) {
+	switch (internal_format) {
+		case GL_RGBA32F: return 16;
+		case GL_RGBA16F: return 8;
+		case GL_R16F: return 2;
+		case GL_DEPTH24_STENCIL8: return 4;
+		case GL_RGBA8: case GL_RGBA: return 4;
+
+		// drivers pad three channel formats to four
+		case GL_RGB8: case GL_RGB: return 4;
+		case GL_ALPHA: return 1;
+	}
+
+	fault("Unsuported texture format: %d!\n", (int) internal_format);
+}
 
 /*
  * Texture
  */
 
+void Texture::account(int width, int height, GLenum internal_format) {
+	memory.resize((size_t) width * height * getPixelSize(internal_format));
+}
+
 GLenum Texture::format(int channels) {
 	switch (channels) {
 		case 4: return GL_RGBA;
@@ -20,7 +43,10 @@ void Texture::framebuffer(GLenum attachment) const {
 }
 
 void Texture::close() {
+	memory.resize(0);
+
 	glDeleteTextures(1, &tid);
+	invalidateBindings();
 }
 
 void Texture::init() {
@@ -51,8 +77,13 @@ void Texture::init(const char* path) {
 }
 
 void Texture::upload(unsigned char* data, int width, int height, int channels) {
+	upload(data, width, height, GL_RGBA, format(channels), GL_UNSIGNED_BYTE);
+}
+
+void Texture::upload(const void* data, int width, int height, GLenum internal_format, GLenum format, GLenum type) {
 	use();
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, format(channels), GL_UNSIGNED_BYTE, data);
+	glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, format, type, data);
+	account(width, height, internal_format);
 	w = width;
 	h = height;
 }
@@ -60,13 +91,37 @@ void Texture::upload(unsigned char* data, int width, int height, int channels) {
 void Texture::resize(int width, int height, GLenum internal_format, GLenum format) {
 	use();
 	glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, format, GL_UNSIGNED_BYTE, nullptr);
+	account(width, height, internal_format);
 	w = width;
 	h = height;
 }
 
+void Texture::setFilter(GLenum filter) {
+	use();
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+}
+
+void Texture::setWrap(GLenum wrap) {
+	use();
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
+}
+
+void Texture::setResource(GpuResource resource, const char* label) {
+	memory.relabel(resource, label);
+}
+
+size_t Texture::getMemory() const {
+	return memory.size();
+}
+
 void Texture::use() const {
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, tid);
+	use(0);
+}
+
+void Texture::use(uint32_t unit) const {
+	bindTexture(unit, tid);
 }
 
 uint32_t Texture::width() const {
@@ -91,12 +146,17 @@ void RenderBuffer::init() {
 }
 
 void RenderBuffer::close() {
+	memory.resize(0);
+
 	glDeleteRenderbuffers(1, &rbo);
 }
 
 void RenderBuffer::resize(int width, int height, GLenum internal_format, GLenum format) {
 	use();
 	glRenderbufferStorage(GL_RENDERBUFFER, internal_format, width, height);
+
+	memory.resize((size_t) width * height * getPixelSize(internal_format));
+
 	w = width;
 	h = height;
 }
@@ -117,33 +177,23 @@ uint32_t RenderBuffer::height() const {
  * TileSet
  */
 
-TileSet::Ref TileSet::of(int x, int y) {
-	return {x, y};
-}
-
 void TileSet::framebuffer(GLenum attachment) const {
-	texture.framebuffer(attachment);
-}
-
-void TileSet::init(const char* path, uint32_t tile) {
-	init(path, tile, tile);
+	atlas->getTexture().framebuffer(attachment);
 }
 
-void TileSet::init(const char* path, uint32_t tw, uint32_t th) {
-
-	this->texture.init(path);
+void TileSet::init(const Atlas& atlas, uint32_t base, uint32_t tw, uint32_t th, uint32_t columns, uint32_t rows) {
+	this->atlas = &atlas;
+	this->base = base;
 	this->tw = tw;
 	this->th = th;
-	this->line = texture.width() / tw;
-	this->column = texture.height() / th;
+	this->line = columns;
+	this->column = rows;
 
-	if (texture.width() % tw != 0 || texture.height() % th != 0) {
-		fault("Unable to neatly divide tileset! Texture width: %d tile width: %d\n", texture.width(), tw);
-	}
-}
+	cells.resize(line * column);
 
-void TileSet::close() {
-	texture.close();
+	for (int index = 0; index < line * column; index ++) {
+		cells[index] = cell(index % line, column - (index / line) - 1);
+	}
 }
 
 void TileSet::resize(int w, int h, GLenum internal_format, GLenum format) {
@@ -151,15 +201,15 @@ void TileSet::resize(int w, int h, GLenum internal_format, GLenum format) {
 }
 
 void TileSet::use() const {
-	texture.use();
+	atlas->use();
 }
 
 uint32_t TileSet::width() const {
-	return texture.width();
+	return atlas->width();
 }
 
 uint32_t TileSet::height() const {
-	return texture.height();
+	return atlas->height();
 }
 
 uint32_t TileSet::columns() const {
@@ -170,27 +220,32 @@ uint32_t TileSet::rows() const {
 	return column;
 }
 
-Sprite TileSet::sprite(int x, int y) {
-	const int min_x = x * tw;
-	const int min_y = y * th;
-	const int max_x = min_x + tw;
-	const int max_y = min_y + th;
+const Sprite& TileSet::sprite(int x, int y) const {
+	return atlas->sprite(cell(x, y));
+}
+
+const Sprite& TileSet::sprite(int index) const {
+	return atlas->sprite(cell(index));
+}
 
-	return {
-		(min_x + 0.01f) / (float) width(),
-		(min_y + 0.01f) / (float) height(),
-		(max_x - 0.01f) / (float) width(),
-		(max_y - 0.01f) / (float) height()
-	};
+const Sprite& TileSet::sprite(Ref ref) const {
+	return atlas->sprite(cell(ref));
 }
 
-Sprite TileSet::sprite(int index) {
-	int x = index % line;
-	int y = column - (index / line) - 1;
+uint32_t TileSet::cell(int x, int y) const {
+	return base + of(x, y).index(line);
+}
+
+uint32_t TileSet::cell(int index) const {
+
+	// text passes raw characters, anything outside of the sheet gets the first sprite, which is blank
+	if (index < 0 || (size_t) index >= cells.size()) {
+		return cells[0];
+	}
 
-	return sprite(x, y);
+	return cells[index];
 }
 
-Sprite TileSet::sprite(Ref ref) {
-	return sprite(ref.x, ref.y);
+uint32_t TileSet::cell(Ref ref) const {
+	return base + ref.index(line);
 }
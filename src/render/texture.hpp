@@ -2,6 +2,7 @@
 
 #include <external.hpp>
 #include "sprite.hpp"
+#include "stats.hpp"
 
 /// Generic pixel buffer
 class PixelBuffer {
@@ -40,9 +41,15 @@ class Texture : public PixelBuffer {
 		uint32_t w = 0;
 		uint32_t h = 0;
 
+		// storage held on the GPU, as reported to the render stats
+		GpuAllocation memory {GpuResource::TEXTURE, "texture"};
+
 		/// Convert channel count to OpenGL enum
 		GLenum format(int channels);
 
+		/// Update the tracked storage after the texture was reallocated
+		void account(int width, int height, GLenum internal_format);
+
 		void framebuffer(GLenum attachment) const override;
 
 	public:
@@ -56,12 +63,30 @@ class Texture : public PixelBuffer {
 		/// Initialize texture of given size and contents
 		void upload(unsigned char* data, int width, int height, int channels);
 
+		/// Initialize texture of given size and contents, in any pixel format
+		void upload(const void* data, int width, int height, GLenum internal_format, GLenum format, GLenum type);
+
 		/// Initialize texture of given size, with undefined contents
 		void resize(int width, int height, GLenum internal_format, GLenum format) override;
 
+		/// Change the minification and magnification filter, textures start out as nearest
+		void setFilter(GLenum filter);
+
+		/// Change the wrapping mode on both axes, textures start out as repeating
+		void setWrap(GLenum wrap);
+
+		/// Change the kind of resource and the label this texture is reported under in the memory stats
+		void setResource(GpuResource resource, const char* label);
+
+		/// Get the size of the texture storage in bytes
+		size_t getMemory() const;
+
 		/// Bind this texture
 		void use() const override;
 
+		/// Bind this texture to the given texture unit
+		void use(uint32_t unit) const;
+
 		/// Get current width in pixels
 		uint32_t width() const override;
 
@@ -78,6 +103,7 @@ class RenderBuffer : public PixelBuffer {
 		uint32_t rbo = 0;
 		uint32_t w = 0;
 		uint32_t h = 0;
+		GpuAllocation memory {GpuResource::TARGET, "render buffer"};
 
 		void framebuffer(GLenum attachment) const override;
 
@@ -98,7 +124,9 @@ class RenderBuffer : public PixelBuffer {
 
 };
 
-/// Managed texture build from smaller regions called sprites
+class Atlas;
+
+/// Sprite sheet packed into an atlas, made of equally sized regions called sprites
 class TileSet : public PixelBuffer {
 
 	public:
@@ -106,25 +134,35 @@ class TileSet : public PixelBuffer {
 		struct Ref {
 			const int x;
 			const int y;
+
+			/// Get the index of this tile within a sheet with the given number of columns
+			constexpr uint32_t index(uint32_t columns) const {
+				return y * columns + x;
+			}
 		};
 
 		/// Create reference for tile [x, y]
-		static Ref of(int x, int y);
+		static constexpr Ref of(int x, int y) {
+			return {x, y};
+		}
 
 	private:
 
-		Texture texture;
+		NULLABLE const Atlas* atlas = nullptr;
+		uint32_t base = 0;
 		int tw, th, line, column;
 
+		// maps the top-down sprite index into the sprite table cell
+		std::vector<uint32_t> cells;
+
 		void framebuffer(GLenum attachment) const override;
 
 	public:
 
 		TileSet() = default;
 
-		void init(const char* path, uint32_t tile);
-		void init(const char* path, uint32_t tw, uint32_t th);
-		void close();
+		/// Called by the atlas once the sheet is packed, base is the sprite table cell of tile [0, 0]
+		void init(const Atlas& atlas, uint32_t base, uint32_t tw, uint32_t th, uint32_t columns, uint32_t rows);
 
 		void resize(int w, int h, GLenum internal_format, GLenum format) override;
 
@@ -136,21 +174,30 @@ class TileSet : public PixelBuffer {
 		/// Get current atlas height in pixels
 		uint32_t height() const override;
 
-		/// Get the number of sprite columns in atlas
+		/// Get the number of sprite columns in this sheet
 		uint32_t columns() const;
 
-		/// Get the number of sprite rows in atlas
+		/// Get the number of sprite rows in this sheet
 		uint32_t rows() const;
 
 	public:
 
 		/// Get given tile from atlas
-		Sprite sprite(int x, int y);
+		const Sprite& sprite(int x, int y) const;
 
 		/// Get Nth sprite from atlas
-		Sprite sprite(int index);
+		const Sprite& sprite(int index) const;
 
 		/// Get sprite by sprite reference
-		Sprite sprite(Ref ref);
+		const Sprite& sprite(Ref ref) const;
 
-};
\ No newline at end of file
+		/// Get the sprite table cell of tile [x, y], as used by the sprite shader
+		uint32_t cell(int x, int y) const;
+
+		/// Get the sprite table cell of Nth sprite, the blank first sprite if the index is out of range
+		uint32_t cell(int index) const;
+
+		/// Get the sprite table cell by sprite reference
+		uint32_t cell(Ref ref) const;
+
+};
@@ -0,0 +1,120 @@
+
+#include "timer.hpp"
+
+/*
+ * GpuTimer
+ */
+
+void GpuTimer::init() {
+	supported = platform_has_timer_query();
+
+	// the debug overlay shows n/a in place of the timings, nothing else depends on them
+	if (!supported) {
+		return;
+	}
+
+	for (auto& queries : this->queries) {
+		glGenQueries(passes, queries.data());
+	}
+
+	glGenQueries(1, &sample);
+}
+
+void GpuTimer::close() {
+	if (!supported) {
+		return;
+	}
+
+	for (auto& queries : this->queries) {
+		glDeleteQueries(passes, queries.data());
+	}
+
+	glDeleteQueries(1, &sample);
+}
+
+void GpuTimer::beginFrame() {
+	if (!supported) {
+		return;
+	}
+
+	set = (set + 1) % sets;
+
+	// something happened to the GPU clock (like a power state change), the results are meaningless
+	#if defined(GL_GPU_DISJOINT)
+		GLint disjoint = 0;
+		glGetIntegerv(GL_GPU_DISJOINT, &disjoint);
+
+		if (disjoint) {
+			pending[set].fill(false);
+			return;
+		}
+	#endif
+
+	for (uint32_t pass = 0; pass < passes; pass ++) {
+		if (!pending[set][pass]) {
+			continue;
+		}
+
+		GLuint available = 0;
+		glGetQueryObjectuiv(queries[set][pass], GL_QUERY_RESULT_AVAILABLE, &available);
+
+		// still not done, rather keep the old time than stall, the query is reused either way
+		if (available) {
+			GLuint nanoseconds = 0;
+			glGetQueryObjectuiv(queries[set][pass], GL_QUERY_RESULT, &nanoseconds);
+			times[pass] = nanoseconds / 1000000.0f;
+		}
+
+		pending[set][pass] = false;
+	}
+}
+
+void GpuTimer::begin(RenderPass pass) {
+	if (supported) {
+		glBeginQuery(GL_TIME_ELAPSED, queries[set][(uint32_t) pass]);
+	}
+}
+
+void GpuTimer::end(RenderPass pass) {
+	if (supported) {
+		glEndQuery(GL_TIME_ELAPSED);
+		pending[set][(uint32_t) pass] = true;
+	}
+}
+
+void GpuTimer::beginSample() {
+	if (supported) {
+		glBeginQuery(GL_TIME_ELAPSED, sample);
+	}
+}
+
+float GpuTimer::endSample() {
+	if (!supported) {
+		return -1;
+	}
+
+	glEndQuery(GL_TIME_ELAPSED);
+
+	// waits until the GPU is done with the sampled work
+	GLuint nanoseconds = 0;
+	glGetQueryObjectuiv(sample, GL_QUERY_RESULT, &nanoseconds);
+
+	#if defined(GL_GPU_DISJOINT)
+		GLint disjoint = 0;
+		glGetIntegerv(GL_GPU_DISJOINT, &disjoint);
+
+		if (disjoint) {
+			return -1;
+		}
+	#endif
+
+	return nanoseconds / 1000000.0f;
+}
+
+bool GpuTimer::isSupported() const {
+	return supported;
+}
+
+float GpuTimer::getTime(RenderPass pass) const {
+	return times[(uint32_t) pass];
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <external.hpp>
+
+/// Render passes timed on the GPU
+enum struct RenderPass : uint8_t {
+	SCENE  = 0, // geometry drawn into the scene target
+	EFFECT = 1, // CRT effect drawn into the back buffer
+};
+
+/// Measures GPU time of each render pass using timer queries, results are read a frame late so that we never wait for them
+class GpuTimer {
+
+	public:
+
+		static constexpr uint32_t passes = 2;
+
+	private:
+
+		// one set of queries is recorded while the other one, from the previous frame, is read back
+		static constexpr uint32_t sets = 2;
+
+		std::array<std::array<GLuint, passes>, sets> queries {};
+		std::array<std::array<bool, passes>, sets> pending {};
+		uint32_t set = 0;
+
+		// used outside of frames, its result is waited for
+		GLuint sample = 0;
+
+		// timer queries are optional, without them all calls do nothing
+		bool supported = false;
+
+		// last known time of each pass in milliseconds
+		std::array<float, passes> times {};
+
+	public:
+
+		GpuTimer() = default;
+
+		void init();
+		void close();
+
+		/// Collect the results of the oldest set of queries, and start recording into it
+		void beginFrame();
+
+		/// Begin timing the given pass, passes can not overlap
+		void begin(RenderPass pass);
+
+		/// Finish timing the current pass
+		void end(RenderPass pass);
+
+		/// Begin timing work outside of the regular passes, can't be used while a pass is timed
+		void beginSample();
+
+		/// Finish timing the sample and wait for its time in milliseconds, negative if it's not known
+		float endSample();
+
+		/// Check if timer queries are available on this device
+		bool isSupported() const;
+
+		/// Get the last known time of the given pass in milliseconds
+		float getTime(RenderPass pass) const;
+
+};
@@ -11,6 +11,72 @@ struct Vert4f4b {
 
 };
 
+/// Compact form of Vert4f4b, positions are stored in fixed point and UVs as normalized shorts
+struct Vert2s2us4b {
+
+	/// Fixed point steps per pixel, positions must stay within +-8K pixels
+	static constexpr float unit = 4.0f;
+
+	int16_t x, y;
+	uint16_t u, v;
+	uint8_t r, g, b, a;
+
+	explicit Vert2s2us4b(const Vert4f4b& vertex)
+	: x(fixed(vertex.x)), y(fixed(vertex.y)), u(normal(vertex.u)), v(normal(vertex.v)), r(vertex.r), g(vertex.g), b(vertex.b), a(vertex.a) {}
+
+	private:
+
+		static int16_t fixed(float value) {
+			return (int16_t) std::clamp(std::round(value * unit), -32768.0f, 32767.0f);
+		}
+
+		static uint16_t normal(float value) {
+			return (uint16_t) std::round(std::clamp(value, 0.0f, 1.0f) * 65535.0f);
+		}
+
+};
+
+/// Memory layout of geometry vertices on the GPU
+enum struct VertexFormat {
+	FULL,    // Vert4f4b, 20 bytes
+	COMPACT, // Vert2s2us4b, 12 bytes
+};
+
+struct SpriteInstance {
+
+	float x, y;
+	float sx, sy;
+	float angle;
+	uint32_t sprite;
+	uint8_t r, g, b, a;
+
+	SpriteInstance(float x, float y, float sx, float sy, float angle, uint32_t sprite, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+	: x(x), y(y), sx(sx), sy(sy), angle(angle), sprite(sprite), r(r), g(g), b(b), a(a) {}
+
+};
+
+/// Electric arc along a row of tiles, the displacement of each column is computed in arc.frag
+struct ArcInstance {
+
+	/// Size of the noise space covered by the arc noise texture before it repeats, must match arc.frag
+	static constexpr int period_x = 64;
+	static constexpr int period_y = 8;
+
+	float x, y;       // bottom left corner of the first column on the baseline, in pixels
+	float length;     // number of tile columns the arc spans
+	float unit;       // size of a single tile in pixels
+	float strength;   // amplitude scaled by power, the displacement grows with it towards the center
+	float phase;      // selects the noise row, arcs with different phases move independently
+	float roughness;  // noise distance between neighbouring columns
+	float shift;      // noise offset, advanced every tick to animate the arc
+	uint32_t sprite;
+	uint8_t r, g, b, a;
+
+	ArcInstance(float x, float y, float length, float unit, float strength, float phase, float roughness, float shift, uint32_t sprite, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+	: x(x), y(y), length(length), unit(unit), strength(strength), phase(phase), roughness(roughness), shift(shift), sprite(sprite), r(r), g(g), b(b), a(a) {}
+
+};
+
 struct Vert2f {
 
 	float x, y;
@@ -21,4 +87,6 @@ struct Vert2f {
 };
 
 static_assert (sizeof(Vert4f4b) == 4 * sizeof(float) + 4 * sizeof(uint8_t), "Vert4f4b is not of the correct size!");
+static_assert (sizeof(Vert2s2us4b) == 2 * sizeof(int16_t) + 2 * sizeof(uint16_t) + 4 * sizeof(uint8_t), "Vert2s2us4b is not of the correct size!");
+static_assert (sizeof(SpriteInstance) == 5 * sizeof(float) + sizeof(uint32_t) + 4 * sizeof(uint8_t), "SpriteInstance is not of the correct size!");
 static_assert (sizeof(Vert2f) == 2 * sizeof(float), "Vert2f is not of the correct size!");
@@ -5,7 +5,9 @@
 #include <render/shader.hpp>
 #include <render/buffer.hpp>
 #include <render/texture.hpp>
+#include <render/atlas.hpp>
 #include <render/framebuffer.hpp>
 #include <render/state.hpp>
 #include <render/vertex.hpp>
 #include <render/screen.hpp>
+#include <render/stats.hpp>
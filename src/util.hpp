@@ -15,8 +15,7 @@ template <typename... Args>
 #pragma GCC diagnostic pop
 
 inline std::mt19937& getRandomGenerator() {
-	static std::random_device device;
-	static std::mt19937 generator(device());
+	static std::mt19937 generator(platform_get_seed());
 
 	return generator;
 }
@@ -0,0 +1,139 @@
+#pragma once
+#include "external.hpp"
+
+/**
+ * Fixed size block allocator, blocks are carved out of large slabs and
+ * recycled through an intrusive free list, so once the slabs are warm
+ * allocation and release are just a pointer swap. Not thread safe.
+ */
+class SlabAllocator {
+
+	public:
+
+		/// Blocks are rounded up to a multiple of this, which also keeps them aligned
+		static constexpr size_t granularity = alignof(std::max_align_t);
+
+		/// Largest block served from a slab, bigger requests go straight to the heap
+		static constexpr size_t max_block = 1024;
+
+	private:
+
+		static constexpr size_t slab_bytes = 64 * 1024;
+
+		struct Block {
+			Block* next;
+		};
+
+		size_t block;
+		Block* free = nullptr;
+		std::vector<std::unique_ptr<uint8_t[]>> slabs;
+
+		void grow() {
+			const size_t count = std::max<size_t>(1, slab_bytes / block);
+			uint8_t* slab = slabs.emplace_back(new uint8_t[count * block]).get();
+
+			// link in reverse, so that blocks are handed out in address order
+			for (size_t i = count; i > 0; i --) {
+				Block* entry = reinterpret_cast<Block*>(slab + (i - 1) * block);
+				entry->next = free;
+				free = entry;
+			}
+		}
+
+	public:
+
+		explicit SlabAllocator(size_t block)
+		: block(std::max(sizeof(Block), (block + granularity - 1) / granularity * granularity)) {}
+
+		void* allocate() {
+			if (free == nullptr) {
+				grow();
+			}
+
+			Block* entry = free;
+			free = entry->next;
+			return entry;
+		}
+
+		void deallocate(void* pointer) {
+			Block* entry = static_cast<Block*>(pointer);
+			entry->next = free;
+			free = entry;
+		}
+
+		/**
+		 * Allocate a block of the given size from the slab of its size class,
+		 * all types of roughly the same size share a single slab
+		 */
+		static void* allocate(size_t size) {
+			if (size > max_block) {
+				return ::operator new(size);
+			}
+
+			return forSize(size).allocate();
+		}
+
+		/**
+		 * Return a block previously allocated with allocate(size),
+		 * the size must be the same as the one that was requested
+		 */
+		static void deallocate(void* pointer, size_t size) {
+			if (size > max_block) {
+				::operator delete(pointer);
+				return;
+			}
+
+			forSize(size).deallocate(pointer);
+		}
+
+	private:
+
+		static SlabAllocator& forSize(size_t size) {
+			static std::array<std::unique_ptr<SlabAllocator>, max_block / granularity> classes;
+			const size_t index = (std::max<size_t>(size, 1) - 1) / granularity;
+
+			if (!classes[index]) {
+				classes[index] = std::make_unique<SlabAllocator>((index + 1) * granularity);
+			}
+
+			return *classes[index];
+		}
+
+};
+
+/**
+ * Slab allocator dedicated to a single type, so that its objects sit next to each
+ * other and don't share slabs with other types that happen to be of the same size
+ */
+template <typename T>
+class SlabPool {
+
+	private:
+
+		static SlabAllocator& get() {
+			static SlabAllocator allocator {sizeof(T)};
+			return allocator;
+		}
+
+	public:
+
+		/// Allocate a block for an object of type T, subclasses without a pool of their own fall back to their size class
+		static void* allocate(size_t size) {
+			if (size != sizeof(T)) {
+				return SlabAllocator::allocate(size);
+			}
+
+			return get().allocate();
+		}
+
+		/// Return a block previously allocated with allocate(size)
+		static void deallocate(void* pointer, size_t size) {
+			if (size != sizeof(T)) {
+				SlabAllocator::deallocate(pointer, size);
+				return;
+			}
+
+			get().deallocate(pointer);
+		}
+
+};